@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "lib/argparser/ArgParser.hpp"
+#include "replay_schema.hpp"
+#include "tests/AllocationCounter.hpp"
+
+/* Replays a corpus captured with ArgParser::StartCorpusCapture against the
+ * schema of DefineReplaySchema: every command line is parsed by the same
+ * parser, as an application that reuses it would do. The first round warms up
+ * the parser and counts the rejected command lines, the following ones are
+ * measured. Allocations are counted by the operator new replaced for the
+ * tests. */
+
+namespace {
+
+double GetPercentile(const std::vector<double>& sorted_values, double percentile) {
+  const auto index = static_cast<size_t>(percentile / 100 * static_cast<double>(sorted_values.size() - 1));
+
+  return sorted_values[index];
+}
+
+}
+
+int main(int argc, char** argv) {
+  std::string corpus_path;
+  uint64_t rounds = 5;
+
+  ArgumentParser::ArgParser options("argparser_corpus_replay");
+  options.AddStringArgument("corpus", "Corpus file").Positional().StoreValue(corpus_path);
+  options.AddUnsignedLongLongArgument('r', "rounds", "Measured rounds").Default(5).StoreValue(rounds);
+  options.AddHelp('h', "help", "Replays a captured argv corpus and reports parsing throughput, latency "
+                               "percentiles and allocations");
+
+  if (!options.Parse(argc, argv, {std::cerr, true})) {
+    std::cerr << options.HelpDescription() << std::endl;
+    return 1;
+  }
+
+  if (options.Help()) {
+    std::cout << options.HelpDescription() << std::endl;
+    return 0;
+  }
+
+  ArgumentParser::ArgvCorpus corpus;
+
+  if (!corpus.Read(corpus_path) || corpus.GetSize() == 0 || rounds == 0) {
+    std::cerr << "Corpus " << corpus_path << " is not readable or empty" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::vector<std::string>> command_lines(corpus.GetSize());
+  size_t corpus_bytes = 0;
+
+  for (size_t i = 0; i < corpus.GetSize(); ++i) {
+    for (const std::string_view arg : corpus.GetCommandLine(i)) {
+      command_lines[i].emplace_back(arg);
+      corpus_bytes += arg.size();
+    }
+  }
+
+  ArgumentParser::ArgParser parser("Replay");
+  DefineReplaySchema(parser);
+  size_t rejected = 0;
+
+  for (const std::vector<std::string>& command_line : command_lines) {
+    rejected += parser.Parse(command_line) ? 0 : 1;
+  }
+
+  std::vector<double> latencies;
+  latencies.reserve(command_lines.size() * rounds);
+  size_t max_allocations = 0;
+  const AllocationCounter total_counter;
+
+  for (uint64_t round = 0; round < rounds; ++round) {
+    for (const std::vector<std::string>& command_line : command_lines) {
+      const AllocationCounter parse_counter;
+      const auto start = std::chrono::steady_clock::now();
+      static_cast<void>(parser.Parse(command_line));
+      const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+      max_allocations = std::max(max_allocations, parse_counter.GetAllocations());
+      latencies.push_back(elapsed.count());
+    }
+  }
+
+  const size_t parses = latencies.size();
+  const auto total_allocations = static_cast<double>(total_counter.GetAllocations());
+  double total_time = 0;
+
+  for (const double latency : latencies) {
+    total_time += latency;
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+
+  std::printf("Command lines:        %zu (%zu bytes), %zu rejected\n", command_lines.size(), corpus_bytes, rejected);
+  std::printf("Throughput:           %.0f lines/s, %.2f MB/s\n",
+              static_cast<double>(parses) / total_time * 1e6,
+              static_cast<double>(corpus_bytes * rounds) / total_time);
+  std::printf("Latency, us:          p50 %.2f, p90 %.2f, p99 %.2f, p99.9 %.2f, max %.2f\n",
+              GetPercentile(latencies, 50), GetPercentile(latencies, 90), GetPercentile(latencies, 99),
+              GetPercentile(latencies, 99.9), latencies.back());
+  std::printf("Allocations per parse: %.2f average, %zu max\n",
+              total_allocations / static_cast<double>(parses), max_allocations);
+
+  return 0;
+}
@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "lib/argparser/ArgParser.hpp"
+#include "lib/argparser/basic/BkTree.hpp"
+
+/* Each scenario prepares its data once and then runs the same work
+ * repeatedly. The best time of one iteration over several rounds is reported
+ * to reduce the noise of the machine; the number of iterations can be passed
+ * as the first argument. */
+
+namespace {
+
+constexpr size_t kRounds = 5;
+
+void Run(const char* name, size_t iterations, const std::function<void()>& parse) {
+  double best_time = 0;
+
+  for (size_t round = 0; round < kRounds; ++round) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < iterations; ++i) {
+      parse();
+    }
+
+    const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    const double time = elapsed.count() / static_cast<double>(iterations);
+    best_time = (round == 0) ? time : std::min(best_time, time);
+  }
+
+  std::printf("%-40s %12.2f us\n", name, best_time);
+}
+
+/* 1000 options of different kinds: flags, integers, strings with a check and
+ * repeated values. The command line sets every tenth of them. */
+
+void ThousandOptions(size_t iterations) {
+  constexpr size_t kOptions = 1000;
+
+  ArgumentParser::ArgParser parser("Benchmark");
+  std::vector<std::string> args = {"app", "input.txt"};
+
+  for (size_t i = 0; i < kOptions; ++i) {
+    const std::string name = "option-" + std::to_string(i);
+
+    switch (i % 4) {
+      case 0:
+        parser.AddFlag(name, "Some flag");
+        break;
+      case 1:
+        parser.AddIntArgument(name, "Some number").Default(0);
+        break;
+      case 2:
+        parser.AddStringArgument(name, "Some string").Default("").AddIsGood([](std::string& value) {
+          return !value.empty();
+        });
+        break;
+      default:
+        parser.AddIntArgument(name, "Some numbers").MultiValue();
+        break;
+    }
+
+    if (i % 10 == 0 || i % 10 == 5) {
+      args.push_back("--" + name + ((i % 4 == 0) ? "" : "=" + std::to_string(i)));
+    }
+  }
+
+  parser.AddStringArgument("input", "Input").Positional().Default("");
+
+  Run("Parse, 1000 options", iterations, [&parser, &args] {
+    if (!parser.Parse(args)) {
+      std::abort();
+    }
+  });
+}
+
+/* Paths of different shapes: absolute and relative, with the file:// scheme,
+ * deep and shallow, every tenth one is invalid because of a doubled slash. */
+
+void ValidatePaths(size_t iterations) {
+  constexpr size_t kPaths = 100000;
+  const char* const kDirectories[] = {"/home/user/projects/argparser", "/var/log/nginx", "build/release/objects",
+                                      "file:///srv/data/archive/2024/06", "./tests/data", "/usr/local/share/doc"};
+
+  std::vector<std::string> paths;
+  paths.reserve(kPaths);
+
+  for (size_t i = 0; i < kPaths; ++i) {
+    std::string path = kDirectories[i % std::size(kDirectories)];
+    path += (i % 10 == 0) ? "//" : "/";
+    path += "module_" + std::to_string(i % 97) + "/file_" + std::to_string(i) + ".cpp";
+    paths.push_back(std::move(path));
+  }
+
+  std::string filename;
+  size_t valid_paths = 0;
+
+  Run("IsValidFilename, 100000 paths", iterations / 10 + 1, [&paths, &filename, &valid_paths] {
+    for (const std::string& path : paths) {
+      filename = path;
+      valid_paths += ArgumentParser::IsValidFilename(filename) ? 1 : 0;
+    }
+  });
+
+  if (valid_paths == 0) {
+    std::abort();
+  }
+}
+
+/* Ten thousand "-D key=value" pairs, stored in a map argument and, for
+ * comparison, collected as strings and split into std::unordered_map. */
+
+void MapPairs(size_t iterations) {
+  constexpr size_t kPairs = 10000;
+  std::vector<std::string> args = {"app"};
+
+  for (size_t i = 0; i < kPairs; ++i) {
+    args.emplace_back("-D");
+    args.push_back("define_" + std::to_string(i) + "=" + std::to_string(i * 3));
+  }
+
+  ArgumentParser::ArgParser map_parser("Map");
+  ArgumentParser::FlatHashMap<int32_t> defines;
+  map_parser.AddIntArgument('D', "define", "Definitions").MultiValue().StoreMap(defines);
+
+  Run("Map argument, 10000 pairs", iterations / 10 + 1, [&map_parser, &args, &defines] {
+    if (!map_parser.Parse(args) || defines.GetSize() != kPairs) {
+      std::abort();
+    }
+  });
+
+  ArgumentParser::ArgParser string_parser("Strings");
+  std::vector<std::string> pairs;
+  std::unordered_map<std::string, int32_t> split_defines;
+  string_parser.AddStringArgument('D', "define", "Definitions").MultiValue().StoreValues(pairs);
+
+  Run("Strings split into unordered_map, 10000 pairs", iterations / 10 + 1, [&string_parser, &args, &pairs,
+      &split_defines] {
+    if (!string_parser.Parse(args)) {
+      std::abort();
+    }
+
+    split_defines.clear();
+
+    for (const std::string& pair : pairs) {
+      const size_t equals_index = pair.find('=');
+      split_defines[pair.substr(0, equals_index)] = std::stoi(pair.substr(equals_index + 1));
+    }
+
+    if (split_defines.size() != kPairs) {
+      std::abort();
+    }
+  });
+}
+
+/* 1500 long options and keys mistyped by one or two edits: the parser
+ * suggests the closest option through its BK-tree, the baseline computes
+ * the edit distance to every option. */
+
+void UnknownKeys(size_t iterations) {
+  constexpr size_t kOptions = 1500;
+  constexpr size_t kKeys = 100;
+  const char* const kWords[] = {"input", "output", "threads", "verbose", "format", "timeout", "cache", "level"};
+  ArgumentParser::ArgParser parser("Benchmark");
+  std::vector<std::string> names;
+  std::vector<std::vector<std::string>> args;
+
+  for (size_t i = 0; i < kOptions; ++i) {
+    names.push_back(std::string(kWords[i % std::size(kWords)]) + "-" + kWords[i / 7 % std::size(kWords)] + "-"
+                        + std::to_string(i));
+  }
+
+  for (const std::string& name : names) {
+    parser.AddIntArgument(name, "Some number").Default(0);
+  }
+
+  for (size_t i = 0; i < kKeys; ++i) {
+    std::string key = names[i * 13 % kOptions];
+    std::swap(key[1], key[2]);
+    args.push_back({"app", "--" + key + "=1"});
+  }
+
+  Run("Unknown keys with suggestions, 1500 options", iterations / 10 + 1, [&parser, &args] {
+    for (const std::vector<std::string>& command_line : args) {
+      if (parser.Parse(command_line) || parser.GetErrors()[0].related.empty()) {
+        std::abort();
+      }
+    }
+  });
+
+  Run("Unknown keys against every option, 1500 options", iterations / 10 + 1, [&names, &args] {
+    std::vector<size_t> row;
+
+    for (const std::vector<std::string>& command_line : args) {
+      const std::string_view key = std::string_view(command_line[1]).substr(2, command_line[1].size() - 4);
+      size_t best_distance = key.size() / 3 + 1;
+
+      for (const std::string& name : names) {
+        best_distance = std::min(best_distance, ArgumentParser::BkTree::GetDistance(key, name, row));
+      }
+
+      if (best_distance > key.size() / 3) {
+        std::abort();
+      }
+    }
+  });
+}
+
+}
+
+int main(int argc, char** argv) {
+  const size_t iterations = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 200;
+
+  ThousandOptions(iterations);
+  ValidatePaths(iterations);
+  MapPairs(iterations);
+  UnknownKeys(iterations);
+
+  return 0;
+}
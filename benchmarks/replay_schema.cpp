@@ -0,0 +1,22 @@
+#include "replay_schema.hpp"
+
+/* A schema of a typical tool: flags, options with values after '=' and after
+ * a space, repeated values, key=value definitions and positional inputs. */
+
+void DefineReplaySchema(ArgumentParser::ArgParser& parser) {
+  static std::vector<std::string> inputs;
+  static ArgumentParser::FlatHashMap<std::string> defines;
+
+  parser.AddHelp('h', "help", "Replay schema");
+  parser.AddFlag('v', "verbose", "Verbose output");
+  parser.AddFlag('q', "quiet", "Quiet output");
+  parser.AddFlag('f', "force", "Overwrite files");
+  parser.AddStringArgument('o', "output", "Output file").Default("a.out");
+  parser.AddIntArgument('j', "jobs", "Number of jobs").Default(1);
+  parser.AddDoubleArgument('t', "threshold", "Threshold").Default(0.5);
+  parser.AddSizeArgument("memory", "Memory limit").Default(ArgumentParser::Size{1 << 30});
+  parser.AddDurationArgument("timeout", "Timeout").Default(ArgumentParser::Duration{});
+  parser.AddStringArgument('I', "include", "Include directories").MultiValue();
+  parser.AddStringArgument('D', "define", "Definitions").MultiValue().StoreMap(defines);
+  parser.AddStringArgument("inputs", "Input files").MultiValue().Positional().StoreValues(inputs);
+}
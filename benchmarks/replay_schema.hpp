@@ -0,0 +1,13 @@
+#ifndef REPLAYSCHEMA_HPP_
+#define REPLAYSCHEMA_HPP_
+
+#include "lib/argparser/ArgParser.hpp"
+
+/**\n This function adds the arguments of the application whose corpus is
+ * replayed. The default definition in replay_schema.cpp is replaced with the
+ * ARGPARSER_REPLAY_SCHEMA option; variables used by StoreValue and
+ * StoreValues must outlive the parser, e.g. be static. */
+
+void DefineReplaySchema(ArgumentParser::ArgParser& parser);
+
+#endif //REPLAYSCHEMA_HPP_
@@ -0,0 +1,69 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "lib/argparser/ArgParser.hpp"
+
+/* The input is split into command line arguments by '\0' and '\n' bytes. The
+ * schema covers all parsing paths: short and long keys, bundled flags, values
+ * after '=' and after a space, MultiValue, Positional and CompositeString. */
+
+namespace {
+
+bool IsGoodName(std::string& value) {
+  return value.size() > 4 && value.substr(value.size() - 4) == ".txt";
+}
+
+std::vector<std::string> SplitInput(const uint8_t* data, size_t size) {
+  std::vector<std::string> args = {"app"};
+  std::string current;
+
+  for (size_t i = 0; i < size; ++i) {
+    const char symbol = static_cast<char>(data[i]);
+
+    if (symbol == '\0' || symbol == '\n') {
+      args.push_back(current);
+      current.clear();
+    } else {
+      current += symbol;
+    }
+  }
+
+  if (!current.empty()) {
+    args.push_back(current);
+  }
+
+  return args;
+}
+
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  ArgumentParser::ArgParser parser("Fuzzer");
+  std::vector<int32_t> numbers;
+  std::vector<double> ratios;
+
+  parser.AddHelp('h', "help", "Fuzzing schema");
+  parser.AddFlag('a', "all", "Flag a");
+  parser.AddFlag('b', "brief", "Flag b").Default(true);
+  parser.AddFlag('c', "color", "Flag c");
+  parser.AddCharArgument('d', "delimiter", "Delimiter").Default(',');
+  parser.AddStringArgument('s', "string", "String").Default("value");
+  parser.AddUnsignedLongLongArgument('u', "unsigned", "Unsigned").Default(0);
+  parser.AddDoubleArgument('r', "ratio", "Ratios").MultiValue().StoreValues(ratios);
+  parser.AddCompositeArgument('i', "input", "Input").AddValidate(&ArgumentParser::IsValidFilename)
+      .AddIsGood(&IsGoodName).Default("input.txt");
+  parser.AddIntArgument("N", "Numbers").MultiValue(1).Positional().StoreValues(numbers);
+
+  if (parser.Parse(SplitInput(data, size))) {
+    static_cast<void>(parser.GetStringValue("string"));
+    static_cast<void>(parser.GetCompositeValue("input"));
+    static_cast<void>(parser.GetFlag("all"));
+  }
+
+  static_cast<void>(parser.HelpDescription());
+  static_cast<void>(parser.ExportState());
+
+  return 0;
+}
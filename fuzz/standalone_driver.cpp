@@ -0,0 +1,45 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+/* This driver replays the inputs through the fuzz target if the compiler does
+ * not provide libFuzzer. Arguments are files or directories with inputs. */
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+namespace {
+
+void RunFile(const std::filesystem::path& path) {
+  std::ifstream stream(path, std::ios::binary);
+  const std::string input{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+  LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+}
+
+}
+
+int main(int argc, char** argv) {
+  size_t runs = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::filesystem::path path(argv[i]);
+
+    if (std::filesystem::is_directory(path)) {
+      for (const auto& entry : std::filesystem::directory_iterator(path)) {
+        if (entry.is_regular_file()) {
+          RunFile(entry.path());
+          ++runs;
+        }
+      }
+    } else {
+      RunFile(path);
+      ++runs;
+    }
+  }
+
+  std::cout << "Executed " << runs << " inputs" << std::endl;
+
+  return 0;
+}
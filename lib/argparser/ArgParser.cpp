@@ -1,5 +1,236 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
 #include "ArgParser.hpp"
 
+#if defined _WIN32 || defined _WIN64 || defined __CYGWIN__
+#define ARGPARSER_ENVIRON _environ
+#else
+extern char** environ;
+#define ARGPARSER_ENVIRON environ
+#endif
+
+namespace {
+
+constexpr char kStateMagic[4] = {'A', 'P', 'S', 'T'};
+constexpr uint32_t kStateVersion = 1;
+
+/* Estimated size of a red-black tree node without its value. */
+
+constexpr size_t kMapNodeOverhead = 4 * sizeof(void*);
+
+enum class CompletionKind {
+  kNone,
+  kFile,
+  kDirectory
+};
+
+struct CompletionEntry {
+  const ArgumentParser::ArgumentInformation* info;
+  bool is_flag;
+  CompletionKind kind;
+};
+
+CompletionKind GetCompletionKind(const ArgumentParser::ArgumentInformation& info) {
+  if (ArgumentParser::IsValidatorFunction(info.is_good, &ArgumentParser::IsDirectory) ||
+      ArgumentParser::IsValidatorFunction(info.validate, &ArgumentParser::IsDirectory)) {
+    return CompletionKind::kDirectory;
+  }
+
+  if (ArgumentParser::IsValidatorFunction(info.is_good, &ArgumentParser::IsRegularFile) ||
+      ArgumentParser::IsValidatorFunction(info.validate, &ArgumentParser::IsRegularFile) ||
+      info.type.find("MappedArray") != std::string_view::npos) {
+    return CompletionKind::kFile;
+  }
+
+  return CompletionKind::kNone;
+}
+
+/* Replaces every character that may not appear in a shell function name. */
+
+std::string GetFunctionName(std::string_view program_name) {
+  std::string function_name = "_";
+
+  for (const char current : program_name) {
+    function_name += std::isalnum(static_cast<unsigned char>(current)) ? current : '_';
+  }
+
+  return function_name + "_completion";
+}
+
+/* Escapes a string for a single-quoted shell word, characters from
+ * special_characters are additionally prefixed with a backslash. */
+
+std::string QuoteForShell(std::string_view text, std::string_view special_characters = {}) {
+  std::string result;
+
+  for (const char current : text) {
+    if (current == '\'') {
+      result += "'\\''";
+    } else {
+      if (special_characters.find(current) != std::string_view::npos) {
+        result += '\\';
+      }
+
+      result += current;
+    }
+  }
+
+  return result;
+}
+
+std::string GetBashCompletion(const std::vector<CompletionEntry>& entries,
+                              std::string_view program_name,
+                              CompletionKind positional_kind) {
+  const std::string function_name = GetFunctionName(program_name);
+  std::string keys;
+  std::string file_keys;
+  std::string directory_keys;
+
+  for (const CompletionEntry& entry : entries) {
+    std::string patterns = "'--" + QuoteForShell(entry.info->long_key) + "'";
+    keys += (keys.empty() ? "--" : " --") + std::string(entry.info->long_key);
+
+    if (entry.info->short_key != ArgumentParser::kBadChar) {
+      patterns += "|'-" + QuoteForShell(std::string(1, entry.info->short_key)) + "'";
+      keys += " -";
+      keys += entry.info->short_key;
+    }
+
+    if (entry.kind == CompletionKind::kFile) {
+      file_keys += (file_keys.empty() ? "" : "|") + patterns;
+    } else if (entry.kind == CompletionKind::kDirectory) {
+      directory_keys += (directory_keys.empty() ? "" : "|") + patterns;
+    }
+  }
+
+  std::string script = function_name + "() {\n";
+  script += "  local cur=\"${COMP_WORDS[COMP_CWORD]}\"\n";
+  script += "  local prev=\"${COMP_WORDS[COMP_CWORD-1]}\"\n";
+  script += "  case \"$prev\" in\n";
+
+  if (!file_keys.empty()) {
+    script += "    " + file_keys + ") COMPREPLY=($(compgen -f -- \"$cur\")); return ;;\n";
+  }
+
+  if (!directory_keys.empty()) {
+    script += "    " + directory_keys + ") COMPREPLY=($(compgen -d -- \"$cur\")); return ;;\n";
+  }
+
+  script += "  esac\n";
+  script += "  if [[ \"$cur\" == -* ]]; then\n";
+  script += "    COMPREPLY=($(compgen -W '" + QuoteForShell(keys) + "' -- \"$cur\"))\n";
+  script += "    return\n";
+  script += "  fi\n";
+
+  if (positional_kind == CompletionKind::kFile) {
+    script += "  COMPREPLY=($(compgen -f -- \"$cur\"))\n";
+  } else if (positional_kind == CompletionKind::kDirectory) {
+    script += "  COMPREPLY=($(compgen -d -- \"$cur\"))\n";
+  } else {
+    script += "  COMPREPLY=()\n";
+  }
+
+  script += "}\n";
+  script += "complete -F " + function_name + " '" + QuoteForShell(program_name) + "'\n";
+
+  return script;
+}
+
+std::string GetZshCompletion(const std::vector<CompletionEntry>& entries,
+                             std::string_view program_name,
+                             CompletionKind positional_kind,
+                             bool has_positional) {
+  constexpr std::string_view kActions[] = {"", "_files", "_files -/"};
+
+  std::string script = "#compdef " + std::string(program_name) + "\n";
+  script += "_arguments -s";
+
+  for (const CompletionEntry& entry : entries) {
+    const std::string long_key = "--" + std::string(entry.info->long_key) + (entry.is_flag ? "" : "=");
+    std::string specification = entry.info->is_multi_value ? "'*'" : "";
+
+    if (entry.info->short_key != ArgumentParser::kBadChar) {
+      if (!entry.info->is_multi_value) {
+        specification += "'(-";
+        specification += entry.info->short_key;
+        specification += " --" + QuoteForShell(entry.info->long_key) + ")'";
+      }
+
+      specification += "{-";
+      specification += entry.info->short_key;
+      specification += ",'" + QuoteForShell(long_key) + "'}";
+    } else {
+      specification += "'" + QuoteForShell(long_key) + "'";
+    }
+
+    specification += "'[" + QuoteForShell(entry.info->description, "[]:\\") + "]";
+
+    if (!entry.is_flag) {
+      specification += ":value:" + std::string(kActions[static_cast<size_t>(entry.kind)]);
+    }
+
+    specification += "'";
+    script += " \\\n  " + specification;
+  }
+
+  if (has_positional) {
+    script += " \\\n  '*:value:" + std::string(kActions[static_cast<size_t>(positional_kind)]) + "'";
+  }
+
+  script += "\n";
+
+  return script;
+}
+
+std::string GetFishCompletion(const std::vector<CompletionEntry>& entries,
+                              std::string_view program_name,
+                              CompletionKind positional_kind) {
+  const std::string command = "complete -c '" + QuoteForShell(program_name) + "'";
+  std::string script;
+
+  if (positional_kind == CompletionKind::kNone) {
+    script += command + " -f\n";
+  }
+
+  for (const CompletionEntry& entry : entries) {
+    script += command;
+
+    if (entry.info->short_key != ArgumentParser::kBadChar) {
+      script += " -s '";
+      script += QuoteForShell(std::string(1, entry.info->short_key));
+      script += "'";
+    }
+
+    script += " -l '" + QuoteForShell(entry.info->long_key) + "'";
+
+    if (!entry.info->description.empty()) {
+      script += " -d '" + QuoteForShell(entry.info->description) + "'";
+    }
+
+    if (!entry.is_flag) {
+      if (entry.kind == CompletionKind::kFile) {
+        script += " -r -F";
+      } else if (entry.kind == CompletionKind::kDirectory) {
+        script += " -r -f -a '(__fish_complete_directories)'";
+      } else {
+        script += " -r -f";
+      }
+    }
+
+    script += "\n";
+  }
+
+  if (positional_kind == CompletionKind::kDirectory) {
+    script += command + " -f -a '(__fish_complete_directories)'\n";
+  }
+
+  return script;
+}
+
+}
+
 ArgumentParser::ArgParser::~ArgParser() {
   for (ArgumentBuilder*& argument_builder : argument_builders_) {
     delete argument_builder;
@@ -20,14 +251,158 @@ bool ArgumentParser::ArgParser::Parse(int argc, char** argv, ConditionalOutput e
   return Parse_(args, error_output);
 }
 
+std::string ArgumentParser::ArgParser::ExportState() const {
+  if (arguments_.size() != argument_builders_.size()) {
+    return {};
+  }
+
+  /* Layout: magic, version, schema hash, number of arguments and then the
+   * values of each argument in the order of addition. The blob contains no
+   * pointers, so it can be passed to another process with the same schema. */
+
+  std::string state(kStateMagic, sizeof(kStateMagic));
+  WriteBinary(state, kStateVersion);
+  WriteBinary(state, GetSchemaHash());
+  WriteBinary(state, static_cast<uint64_t>(arguments_.size()));
+
+  for (const Argument* argument : arguments_) {
+    if (!argument->ExportValues(state)) {
+      return {};
+    }
+  }
+
+  return state;
+}
+
+bool ArgumentParser::ArgParser::ImportState(std::string_view state, ConditionalOutput error_output) {
+  uint32_t version = 0;
+  uint64_t schema_hash = 0;
+  uint64_t arguments_count = 0;
+
+  if (state.size() < sizeof(kStateMagic) || state.substr(0, sizeof(kStateMagic)) != std::string_view(kStateMagic, 4)) {
+    DisplayError("Passed state is not an exported parser state.\n", error_output);
+    return false;
+  }
+
+  state.remove_prefix(sizeof(kStateMagic));
+
+  if (!ReadBinary(state, version) || !ReadBinary(state, schema_hash) || !ReadBinary(state, arguments_count) ||
+      version != kStateVersion || schema_hash != GetSchemaHash() || arguments_count != argument_builders_.size()) {
+    DisplayError("Passed state does not match the parser.\n", error_output);
+    return false;
+  }
+
+  RefreshArguments();
+
+  for (Argument* argument : arguments_) {
+    if (!argument->ImportValues(state)) {
+      DisplayError("Passed state is corrupted.\n", error_output);
+      RefreshArguments();
+      return false;
+    }
+  }
+
+  return HandleErrors(error_output);
+}
+
+bool ArgumentParser::ArgParser::StartCorpusCapture(const std::string& path, size_t sample_period) {
+  return corpus_.StartCapture(path, sample_period);
+}
+
+void ArgumentParser::ArgParser::StopCorpusCapture() {
+  corpus_.StopCapture();
+}
+
+bool ArgumentParser::ArgParser::ReadConfig(const std::string& path) {
+  return config_.Read(path);
+}
+
+bool ArgumentParser::ArgParser::WriteConfigSnapshot(const std::string& path) const {
+  return config_.WriteSnapshot(path);
+}
+
+ArgumentParser::MemoryUsageReport ArgumentParser::ArgParser::MemoryUsage() const {
+  MemoryUsageReport report;
+  report.parser = sizeof(*this) + (argument_builders_.capacity() + arguments_.capacity()) * sizeof(void*);
+
+  for (const ArgumentBuilder* argument_builder : argument_builders_) {
+    argument_builder->AddMemoryUsage(report);
+  }
+
+  for (const Argument* argument : arguments_) {
+    argument->AddMemoryUsage(report);
+  }
+
+  report.type_names = (allowed_typenames_.capacity() + allowed_typenames_for_help_.capacity()) *
+      sizeof(std::string_view);
+
+  for (const auto& t_arguments : arguments_by_type_ | std::views::values) {
+    report.lookup_tables += kMapNodeOverhead + sizeof(std::pair<const std::string_view, std::map<std::string_view, size_t>>);
+    report.lookup_tables += t_arguments.size() * (kMapNodeOverhead + sizeof(std::pair<const std::string_view, size_t>));
+  }
+
+  report.lookup_tables += flag_slots_.capacity() * sizeof(uint32_t) + constraints_.GetMemoryUsage();
+  report.lookup_tables += flag_slots_by_name_.size() * (kMapNodeOverhead + sizeof(std::pair<const std::string_view, uint32_t>));
+  report.lookup_tables += argument_traits_.capacity() * sizeof(ArgumentTraits);
+  report.stored_values += flag_values_.GetMemoryUsage();
+
+  return report;
+}
+
+const std::vector<ArgumentParser::ParsingError>& ArgumentParser::ArgParser::GetErrors() const {
+  return errors_;
+}
+
+std::string ArgumentParser::ArgParser::CompletionScript(CompletionShell shell,
+                                                       const std::string_view& program_name) const {
+  /* The script is generated from the schema only, so completion runs as a
+   * shell function without starting the program. */
+
+  std::vector<CompletionEntry> entries;
+  CompletionKind positional_kind = CompletionKind::kNone;
+  bool has_positional = false;
+
+  for (const ArgumentBuilder* argument_builder : argument_builders_) {
+    const ArgumentInformation& info = argument_builder->GetInfo();
+    const CompletionKind kind = GetCompletionKind(info);
+    entries.push_back({&info, info.type == typeid(bool).name(), kind});
+
+    if (info.is_positional) {
+      has_positional = true;
+      positional_kind = std::max(positional_kind, kind);
+    }
+  }
+
+  switch (shell) {
+    case CompletionShell::kBash:
+      return GetBashCompletion(entries, program_name, positional_kind);
+    case CompletionShell::kZsh:
+      return GetZshCompletion(entries, program_name, positional_kind, has_positional);
+    case CompletionShell::kFish:
+      return GetFishCompletion(entries, program_name, positional_kind);
+  }
+
+  return {};
+}
+
 bool ArgumentParser::ArgParser::Help() const {
   if (help_index_ == std::string::npos) {
     return false;
   }
 
-  const auto* help_argument = dynamic_cast<ConcreteArgument<bool>*>(arguments_[help_index_]);
+  return flag_values_.Test(flag_slots_[help_index_]);
+}
+
+std::string_view ArgumentParser::ArgParser::GetStringView(const std::string_view& long_name, size_t index) const {
+  return GetValueReference<std::string>(long_name, index);
+}
+
+bool ArgumentParser::ArgParser::GetFlag(const std::string_view& long_name, size_t index) const {
+  if (index != 0) {
+    return GetValue_<bool>(long_name, index);
+  }
 
-  return help_argument->GetValue(0);
+  return flag_values_.Test(flag_slots_by_name_.at(long_name));
 }
 
 std::string ArgumentParser::ArgParser::HelpDescription() const {
@@ -43,7 +418,7 @@ std::string ArgumentParser::ArgParser::HelpDescription() const {
 
   for (size_t i = 0; i < allowed_typenames_.size(); ++i) {
     std::string_view type_name = allowed_typenames_[i];
-    std::string output_type_name = allowed_typenames_for_help_[i];
+    std::string_view output_type_name = allowed_typenames_for_help_[i];
 
     for (const auto& index : arguments_by_type_.at(type_name) | std::views::values) {
       if (index == help_index_) {
@@ -51,29 +426,30 @@ std::string ArgumentParser::ArgParser::HelpDescription() const {
       }
 
       ArgumentBuilder* argument = argument_builders_[index];
-      auto [short_key, long_key, description, type, minimum_values, is_multi_value, is_positional, has_store_values,
-        has_store_value, has_default, validate, is_good] = argument->GetInfo();
-      help += short_key == kBadChar ? "     " : std::string("-") + short_key + ",  ";
+      const ArgumentInformation& info = argument->GetInfo();
+      help += info.short_key == kBadChar ? "     " : std::string("-") + info.short_key + ",  ";
       help += "--";
-      help += long_key;
+      help += info.long_key;
 
       if (type_name != typeid(bool).name()) {
-        help += "=<" + output_type_name + ">";
+        help += "=<";
+        help += output_type_name;
+        help += ">";
       }
 
       help += ":  ";
-      help += description;
+      help += info.description;
 
       help += " [";
-      if (is_multi_value) {
+      if (info.is_multi_value) {
         help += "repeated, ";
       }
 
-      if (is_positional) {
+      if (info.is_positional) {
         help += "positional, ";
       }
 
-      if (has_default && (type_name != typeid(bool).name() || argument->GetDefaultValue() != "0")) {
+      if (info.has_default && (type_name != typeid(bool).name() || argument->GetDefaultValue() != "0")) {
         help += "default = ";
 
         if (type_name == typeid(bool).name()) {
@@ -85,14 +461,20 @@ std::string ArgumentParser::ArgParser::HelpDescription() const {
         help += ", ";
       }
 
-      if (minimum_values != 0 && is_multi_value) {
-        help += "min args = " + std::to_string(minimum_values);
+      if (!info.environment_variable.empty()) {
+        help += "env = ";
+        help += info.environment_variable;
+        help += ", ";
+      }
+
+      if (info.minimum_values != 0 && info.is_multi_value) {
+        help += "min args = " + std::to_string(info.minimum_values);
       }
 
       bool was_extended = help.back() != '[';
 
       if (!was_extended || help.back() == ' ') {
-        help = help.substr(0, help.size() - 2);
+        help.resize(help.size() - 2);
       }
 
       if (was_extended) {
@@ -105,11 +487,10 @@ std::string ArgumentParser::ArgParser::HelpDescription() const {
 
   help += "\n";
   ArgumentBuilder* argument = argument_builders_[help_index_];
-  auto [short_key, long_key, description, type, minimum_values, is_multi_value, is_positional, has_store_values,
-    has_store_value, has_default, validate, is_good] = argument->GetInfo();
-  help += short_key == kBadChar ? "     " : std::string("-") + short_key + ",  ";
+  const ArgumentInformation& info = argument->GetInfo();
+  help += info.short_key == kBadChar ? "     " : std::string("-") + info.short_key + ",  ";
   help += "--";
-  help += long_key;
+  help += info.long_key;
   help += ":  Display this help and exit";
   help += "\n";
 
@@ -130,161 +511,348 @@ ArgumentParser::ConcreteArgumentBuilder<bool>& ArgumentParser::ArgParser::AddHel
 }
 
 bool ArgumentParser::ArgParser::Parse_(const std::vector<std::string>& args, ConditionalOutput error_output) {
+  corpus_.Capture(args);
   RefreshArguments();
-  std::vector<size_t> used_positions = {0};
-  std::vector<std::string> argv = args;
+  std::vector<Token>& argv = buffers_.tokens;
+  std::vector<size_t>& used_positions = buffers_.used_positions;
+  std::vector<size_t>& argument_indices = buffers_.argument_indices;
 
-  for (std::string& arg : argv) {
-    if (arg[0] == '\'' || arg[0] == '"') {
-      arg = arg.substr(1);
-    }
+  /* Every token is classified once, the later stages read its kind, key and
+   * value instead of scanning it again. */
 
-    if (arg.back() == '\'' || arg.back() == '"') {
-      arg = arg.substr(0, arg.size() - 1);
-    }
-  }
+  ClassifyTokens(args, argv);
+
+  /* An option or a positional argument uses a token at most once, so the
+   * position buffers are reserved for all tokens and grow once. */
+
+  used_positions.reserve(argv.size());
+  used_positions.assign(1, 0);
+  buffers_.value_positions.reserve(argv.size());
+  buffers_.positional_args.reserve(argv.size());
 
-  argv.emplace_back("--");
+  path_cache_.Clear();
+  const ScopedPathCache scoped_path_cache(path_cache_);
+  PrefetchPaths(argv);
 
-  for (size_t position = 1; position < argv.size() && argv[position] != "--"; ++position) {
-    if (argv[position][0] == '-') {
-      if (argv[position].size() == 1) {
+  for (size_t position = 1; position < argv.size() && !argv[position].IsTerminator(); ++position) {
+    if (!argv[position].IsValue()) {
+      if (argv[position].text.size() == 1) {
         return false;
       }
 
-      std::vector<std::string_view> long_keys = GetLongKeys(argv[position]);
-
-      if (long_keys.empty()) {
-        DisplayError("Used nonexistent argument: " + argv[position] + "\n", error_output);
+      if (!GetArgumentIndices(argv[position], argument_indices)) {
+        AddUnknownArgumentError(argv[position], error_output);
         return false;
       }
 
-      for (const std::string_view& long_key : long_keys) {
-        bool was_found = false;
-
-        for (const std::string_view& type_name : allowed_typenames_) {
-          const std::map<std::string_view, size_t>* t_arguments = &arguments_by_type_.at(type_name);
-
-          if (t_arguments->contains(long_key)) {
-            was_found = true;
-            std::vector<size_t> current_used_positions =
-                arguments_[t_arguments->at(long_key)]->ValidateArgument(argv, position);
-            position = (current_used_positions.empty()) ? position : current_used_positions.back();
-            used_positions.insert(std::end(used_positions),
-                                  std::begin(current_used_positions),
-                                  std::end(current_used_positions));
-          }
-
-          if (was_found) {
-            break;
-          }
-        }
+      /* All keys of a bundle like "-abc" are validated from the position of
+       * the bundle itself, the next position is the farthest one used. */
 
-        if (!was_found) {
-          DisplayError("Used nonexistent argument: " + argv[position] + "\n", error_output);
-          return false;
-        }
+      const size_t key_position = position;
+
+      for (const size_t argument_index : argument_indices) {
+        position = std::max(position, arguments_[argument_index]->ValidateArgument(argv, key_position, used_positions));
       }
     }
   }
 
   ParsePositionalArguments(argv, used_positions);
+  ApplyFallbackValues();
 
   return HandleErrors(error_output);
 }
 
-std::vector<std::string_view> ArgumentParser::ArgParser::GetLongKeys(const std::string_view& current_argument) const {
-  std::string_view one_long_key = current_argument.substr(2);
-  std::string_view result_key;
+bool ArgumentParser::ArgParser::GetArgumentIndices(const Token& token, std::vector<size_t>& argument_indices) const {
+  argument_indices.clear();
 
-  if (one_long_key.find('=') != std::string::npos) {
-    result_key = one_long_key.substr(0, one_long_key.find('='));
-  } else {
-    result_key = one_long_key;
+  if (token.IsValue() || token.IsTerminator()) {
+    return false;
   }
 
-  std::vector<std::string_view> long_keys;
+  if (token.kind != TokenKind::kLongKey) {
+    /* Short keys are resolved through a table indexed by the character, the
+     * bundle ends at the first character that is not a short key. */
+
+    for (const char key : token.key) {
+      const uint32_t argument_index = short_key_indices_[static_cast<unsigned char>(key)];
+
+      if (argument_index == kNoIndex) {
+        break;
+      }
 
-  if (current_argument[1] != '-') {
-    for (size_t current_key_index = 1;
-         current_key_index < current_argument.size() &&
-         short_to_long_names_.contains(current_argument[current_key_index]);
-         ++current_key_index) {
-      long_keys.emplace_back(short_to_long_names_.at(current_argument[current_key_index]));
+      argument_indices.push_back(argument_index);
     }
   } else {
-    long_keys.push_back(result_key);
+    const size_t argument_index = FindArgumentIndex(token.key);
+
+    if (argument_index != std::string::npos) {
+      argument_indices.push_back(argument_index);
+    }
   }
 
-  return long_keys;
+  return !argument_indices.empty();
 }
 
-void ArgumentParser::ArgParser::ParsePositionalArguments(const std::vector<std::string>& argv,
-                                                         const std::vector<size_t>& used_positions) const {
-  std::vector<std::string> positional_args = {};
-  std::vector<size_t> positional_indices = {};
+void ArgumentParser::ArgParser::ParsePositionalArguments(std::span<const Token> argv,
+                                                         const std::vector<size_t>& used_positions) {
+  std::vector<Token>& positional_args = buffers_.positional_args;
+  std::vector<bool>& is_used = buffers_.is_used_position;
 
-  for (size_t i = 0; i < arguments_.size(); ++i) {
-    if (arguments_[i]->GetInfo().is_positional) {
-      positional_indices.push_back(i);
+  /* Options repeated thousands of times use as many positions, so they are
+   * marked once instead of being searched for every token. */
+
+  is_used.assign(argv.size(), false);
+
+  for (const size_t position : used_positions) {
+    if (position < is_used.size()) {
+      is_used[position] = true;
     }
   }
 
+  positional_args.clear();
+
   for (size_t i = 0; i < argv.size(); ++i) {
-    if (std::ranges::find(used_positions, i) == std::end(used_positions)) {
+    if (!is_used[i]) {
       positional_args.push_back(argv[i]);
     }
   }
 
   for (size_t position = 0, argument_index = 0;
        position < positional_args.size() &&
-       argument_index < positional_indices.size() &&
-       positional_args[position] != "--";
+       argument_index < positional_indices_.size() &&
+       !positional_args[position].IsTerminator();
        ++position, ++argument_index) {
-    std::vector<size_t> current_used_positions =
-        arguments_[positional_indices[argument_index]]->ValidateArgument(positional_args, position);
-    position = (current_used_positions.empty()) ? position : current_used_positions.back();
+    buffers_.value_positions.clear();
+    position = arguments_[positional_indices_[argument_index]]->ValidateArgument(positional_args, position,
+                                                                                 buffers_.value_positions);
+  }
+}
+
+void ArgumentParser::ArgParser::PrefetchPaths(std::span<const Token> argv) {
+  const bool uses_paths = std::ranges::any_of(argument_traits_, [](const ArgumentTraits& traits) {
+    return traits.Has(ArgumentTraits::kPathCheck);
+  });
+
+  if (!uses_paths) {
+    return;
+  }
+
+  /* Every value that can be passed to an argument is a candidate path, the
+   * cache queries all of them at once instead of one by one during parsing. */
+
+  std::vector<std::string_view>& candidates = buffers_.path_candidates;
+  candidates.clear();
+
+  for (size_t position = 1; position < argv.size(); ++position) {
+    if (argv[position].IsValue()) {
+      candidates.push_back(argv[position].text);
+    } else if (argv[position].has_value) {
+      candidates.push_back(argv[position].value);
+    }
+  }
+
+  path_cache_.Prefetch(candidates);
+}
+
+void ArgumentParser::ArgParser::ApplyFallbackValues() {
+  /* Values are taken with the priority: command line, environment variable,
+   * configuration file, default value. A fallback source is used only if the
+   * argument was not used on the command line, even without a valid value. */
+
+  std::vector<std::string_view>& environment_values = buffers_.environment_values;
+  std::vector<bool>& is_resolved = buffers_.is_resolved;
+  ScanEnvironment(environment_values);
+  is_resolved.assign(arguments_.size(), false);
+
+  for (size_t i = 0; i < arguments_.size(); ++i) {
+    is_resolved[i] = arguments_[i]->GetValueStatus() != ArgumentParsingStatus::kNoArgument;
+
+    if (!is_resolved[i] && !environment_values[i].empty()) {
+      const Token fallback_token = {{}, arguments_[i]->GetInfo().long_key, environment_values[i], TokenKind::kLongKey, true};
+      buffers_.value_positions.clear();
+      arguments_[i]->ValidateArgument({&fallback_token, 1}, 0, buffers_.value_positions);
+      is_resolved[i] = true;
+    }
+  }
+
+  for (const auto& [key, value] : config_.GetEntries()) {
+    const size_t index = FindArgumentIndex(key);
+
+    if (index == std::string::npos || is_resolved[index]) {
+      continue;
+    }
+
+    const Token fallback_token = {{}, key, value, TokenKind::kLongKey, true};
+    buffers_.value_positions.clear();
+    arguments_[index]->ValidateArgument({&fallback_token, 1}, 0, buffers_.value_positions);
+  }
+}
+
+void ArgumentParser::ArgParser::ScanEnvironment(std::vector<std::string_view>& environment_values) const {
+  environment_values.assign(arguments_.size(), {});
+
+  if (environment_indices_.empty() || ARGPARSER_ENVIRON == nullptr) {
+    return;
+  }
+
+  /* The environment is scanned exactly once, each entry is matched against
+   * all requested variables at the same time. */
+
+  for (char** entry = ARGPARSER_ENVIRON; *entry != nullptr; ++entry) {
+    const std::string_view current(*entry);
+    const size_t equals_index = current.find('=');
+
+    if (equals_index == std::string_view::npos) {
+      continue;
+    }
+
+    /* Several arguments may share a variable, all of them take its value. */
+
+    const auto [first, last] = std::ranges::equal_range(environment_indices_, current.substr(0, equals_index),
+                                                        {}, &std::pair<std::string_view, size_t>::first);
+
+    for (auto it = first; it != last; ++it) {
+      environment_values[it->second] = current.substr(equals_index + 1);
+    }
   }
 }
 
+uint64_t ArgumentParser::ArgParser::GetSchemaHash() const {
+  /* FNV-1a hash of the names and types of all arguments. */
+
+  uint64_t hash = 14695981039346656037ULL;
+  const auto append = [&hash](std::string_view data) {
+    for (const char current : data) {
+      hash ^= static_cast<unsigned char>(current);
+      hash *= 1099511628211ULL;
+    }
+
+    hash ^= 0xFF;
+    hash *= 1099511628211ULL;
+  };
+
+  for (const ArgumentBuilder* argument_builder : argument_builders_) {
+    append(argument_builder->GetInfo().long_key);
+    append(argument_builder->GetInfo().type);
+  }
+
+  return hash;
+}
+
+size_t ArgumentParser::ArgParser::FindArgumentIndex(const std::string_view& long_key) const {
+  for (const std::string_view& type_name : allowed_typenames_) {
+    const std::map<std::string_view, size_t>& t_arguments = arguments_by_type_.at(type_name);
+    const auto it = t_arguments.find(long_key);
+
+    if (it != t_arguments.end()) {
+      return it->second;
+    }
+  }
+
+  return std::string::npos;
+}
+
 void ArgumentParser::ArgParser::RefreshArguments() {
+  errors_.clear();
+
+  /* The arguments are rebuilt only if an argument was added or a builder has
+   * changed since they were built, otherwise they are just cleared. */
+
+  const bool is_built = std::ranges::equal(argument_builders_, built_revisions_, {}, &ArgumentBuilder::GetRevision);
+
   for (Argument* argument : arguments_) {
     argument->ClearStored();
-    delete argument;
+
+    if (!is_built) {
+      delete argument;
+    }
+  }
+
+  if (is_built) {
+    return;
   }
 
   arguments_.clear();
+  argument_traits_.clear();
+  built_revisions_.clear();
+  positional_indices_.clear();
+  environment_indices_.clear();
+  long_key_tree_.Clear();
+  constraints_.Compile(argument_builders_);
+  arguments_.reserve(argument_builders_.size());
+  argument_traits_.reserve(argument_builders_.size());
+  built_revisions_.reserve(argument_builders_.size());
+  long_key_tree_.Reserve(argument_builders_.size());
 
   for (ArgumentBuilder* argument_builder : argument_builders_) {
     arguments_.push_back(argument_builder->build());
+    argument_traits_.push_back(arguments_.back()->GetTraits());
+    built_revisions_.push_back(argument_builder->GetRevision());
+
+    if (flag_slots_[arguments_.size() - 1] != kNoIndex) {
+      static_cast<ConcreteArgument<bool>*>(arguments_.back())->BindFlagSlot(flag_values_,
+                                                                             flag_slots_[arguments_.size() - 1]);
+    }
+
+    if (argument_traits_.back().Has(ArgumentTraits::kPositional)) {
+      positional_indices_.push_back(arguments_.size() - 1);
+    }
+
+    if (argument_traits_.back().Has(ArgumentTraits::kEnvironment)) {
+      environment_indices_.emplace_back(arguments_.back()->GetInfo().environment_variable, arguments_.size() - 1);
+    }
+
+    if (!arguments_.back()->GetInfo().long_key.empty()) {
+      long_key_tree_.Insert(arguments_.back()->GetInfo().long_key);
+    }
   }
-}
 
-bool ArgumentParser::ArgParser::HandleErrors(ConditionalOutput error_output) const {
-  std::string error_string;
-  bool is_correct = true;
+  std::ranges::sort(environment_indices_);
+}
 
+bool ArgumentParser::ArgParser::HandleErrors(ConditionalOutput error_output) {
   if (help_index_ != std::string::npos && Help()) {
     return true;
   }
 
-  for (const auto& argument : arguments_) {
+  used_arguments_.Resize(arguments_.size());
+
+  for (size_t i = 0; i < arguments_.size(); ++i) {
+    Argument* argument = arguments_[i];
+    used_arguments_.Set(i, argument->GetUsedValues() != 0);
+
     if (!argument->CheckLimit()) {
-      error_string += "Not enough values were passed to argument --";
-      error_string += argument->GetInfo().long_key;
-      error_string += ".\n";
-      is_correct = false;
+      errors_.push_back({ParsingErrorKind::kInsufficientArguments, std::string(argument->GetInfo().long_key), {}});
     }
 
     if (argument->GetValueStatus() == ArgumentParsingStatus::kInvalidArgument) {
-      error_string += "An incorrect value was passed to the --";
-      error_string += argument->GetInfo().long_key;
-      error_string += " argument.\n";
-      is_correct = false;
+      errors_.push_back({ParsingErrorKind::kInvalidArgument, std::string(argument->GetInfo().long_key), {}});
     }
   }
 
+  constraints_.Check(used_arguments_, errors_);
+
+  std::string error_string;
+
+  for (const ParsingError& error : errors_) {
+    error_string += error.GetMessage();
+  }
+
   DisplayError(error_string, error_output);
 
-  return is_correct;
+  return errors_.empty();
+}
+
+void ArgumentParser::ArgParser::AddUnknownArgumentError(const Token& token, ConditionalOutput error_output) {
+  /* Only long keys get a suggestion: a mistyped short key is a single
+   * character, which is within one edit of any other. */
+
+  std::string_view suggestion;
+
+  if (token.kind == TokenKind::kLongKey && !token.key.empty()) {
+    suggestion = long_key_tree_.FindClosest(token.key, std::max<size_t>(1, token.key.size() / 3));
+  }
+
+  errors_.push_back({ParsingErrorKind::kUnknownArgument, std::string(token.text), std::string(suggestion)});
+  DisplayError(errors_.back().GetMessage(), error_output);
 }
@@ -7,17 +7,31 @@ inline auto highLevelF(Args&&... args) -> decltype(lowLevelF(std::forward<Args>(
     return lowLevelF(std::forward<Args>(args)...); \
 }
 
+#include <array>
+#include <limits>
 #include <string>
 #include <vector>
 #include <string_view>
 #include <typeinfo>
+#include <type_traits>
 #include <map>
 #include <ranges>
+#include <span>
 
 #include "ConcreteArgumentBuilder.hpp"
 #include "ConcreteArgument.hpp"
 #include "ArgParserConcepts.hpp"
+#include "ArgvCorpus.hpp"
+#include "ConfigFile.hpp"
+#include "ConstraintSet.hpp"
+#include "MappedArray.hpp"
+#include "ParsingError.hpp"
+#include "Token.hpp"
 #include "lib/argparser/basic/BasicFunctions.hpp"
+#include "lib/argparser/basic/BkTree.hpp"
+#include "lib/argparser/basic/OutputSink.hpp"
+#include "lib/argparser/basic/PathCache.hpp"
+#include "lib/argparser/basic/SlotBitset.hpp"
 
 namespace ArgumentParser {
 template<ProperArgumentType ... Args>
@@ -27,6 +41,38 @@ struct ArgumentTypes {
   }
 };
 
+template<typename T>
+struct IsMappedArray : std::false_type {};
+
+template<typename T>
+struct IsMappedArray<MappedArray<T>> : std::true_type {};
+
+/**\n Size, Duration, Rate and MappedArray are registered by a parser when the
+ * first argument of the type is added, so parsers that do not use them do not
+ * keep type tables for them. This function returns the help name of such a
+ * type and an empty view for the other types. */
+
+template<typename T>
+constexpr std::string_view GetOnDemandTypeName() {
+  if constexpr (std::is_same_v<T, Size>) {
+    return "size";
+  } else if constexpr (std::is_same_v<T, Duration>) {
+    return "duration";
+  } else if constexpr (std::is_same_v<T, Rate>) {
+    return "rate";
+  } else if constexpr (IsMappedArray<T>::value) {
+    return T::kTypeName;
+  } else {
+    return {};
+  }
+}
+
+enum class CompletionShell {
+  kBash,
+  kZsh,
+  kFish
+};
+
 class ArgParser {
   public:
     template<ProperArgumentType ... Args>
@@ -39,9 +85,24 @@ class ArgParser {
     bool Parse(const std::vector<std::string>& args, ConditionalOutput error_output = {});
     bool Parse(int argc, char** argv, ConditionalOutput error_output = {});
 
+    [[nodiscard]] std::string ExportState() const;
+    bool ImportState(std::string_view state, ConditionalOutput error_output = {});
+
+    bool StartCorpusCapture(const std::string& path, size_t sample_period = 1);
+    void StopCorpusCapture();
+
+    bool ReadConfig(const std::string& path);
+    [[nodiscard]] bool WriteConfigSnapshot(const std::string& path) const;
+
+    [[nodiscard]] MemoryUsageReport MemoryUsage() const;
+
+    [[nodiscard]] const std::vector<ParsingError>& GetErrors() const;
+
     [[nodiscard]] bool Help() const;
     [[nodiscard]] std::string HelpDescription() const;
 
+    [[nodiscard]] std::string CompletionScript(CompletionShell shell, const std::string_view& program_name) const;
+
     ConcreteArgumentBuilder<bool>& AddHelp(char short_name,
                                            const std::string_view& long_name,
                                            const std::string& description = "");
@@ -56,11 +117,24 @@ class ArgParser {
     ConcreteArgumentBuilder<T>& AddArgument(const std::string_view& long_name, const std::string& description = "");
 
     template<ProperArgumentType T>
+    requires std::copy_constructible<T>
     T GetValue(const std::string_view& long_name, size_t index = 0) const;
 
+    template<ProperArgumentType T>
+    requires (!std::is_same_v<T, bool>)
+    const T& GetValueReference(const std::string_view& long_name, size_t index = 0) const;
+
+    template<ProperArgumentType T>
+    requires (!std::is_same_v<T, bool>)
+    std::span<const T> GetValues(const std::string_view& long_name) const;
+
+    [[nodiscard]] std::string_view GetStringView(const std::string_view& long_name, size_t index = 0) const;
+
     template<ProperArgumentType T>
     void SetAliasForType(const std::string& alias);
 
+    [[nodiscard]] bool GetFlag(const std::string_view& long_name, size_t index = 0) const;
+
     ALIAS_TEMPLATE_FUNCTION(AddShortArgument, AddArgument<int16_t>);
     ALIAS_TEMPLATE_FUNCTION(AddIntArgument, AddArgument<int32_t>);
     ALIAS_TEMPLATE_FUNCTION(AddLongLongArgument, AddArgument<int64_t>);
@@ -70,6 +144,9 @@ class ArgParser {
     ALIAS_TEMPLATE_FUNCTION(AddFloatArgument, AddArgument<float>);
     ALIAS_TEMPLATE_FUNCTION(AddDoubleArgument, AddArgument<double>);
     ALIAS_TEMPLATE_FUNCTION(AddLongDoubleArgument, AddArgument<long double>);
+    ALIAS_TEMPLATE_FUNCTION(AddSizeArgument, AddArgument<Size>);
+    ALIAS_TEMPLATE_FUNCTION(AddDurationArgument, AddArgument<Duration>);
+    ALIAS_TEMPLATE_FUNCTION(AddRateArgument, AddArgument<Rate>);
     ALIAS_TEMPLATE_FUNCTION(AddFlag, AddArgument<bool>);
     ALIAS_TEMPLATE_FUNCTION(AddCharArgument, AddArgument<char>);
     ALIAS_TEMPLATE_FUNCTION(AddStringArgument, AddArgument<std::string>);
@@ -84,44 +161,98 @@ class ArgParser {
     ALIAS_TEMPLATE_FUNCTION(GetFloatValue, GetValue<float>);
     ALIAS_TEMPLATE_FUNCTION(GetDoubleValue, GetValue<double>);
     ALIAS_TEMPLATE_FUNCTION(GetLongDoubleValue, GetValue<long double>);
-    ALIAS_TEMPLATE_FUNCTION(GetFlag, GetValue<bool>);
+    ALIAS_TEMPLATE_FUNCTION(GetSizeValue, GetValue<Size>);
+    ALIAS_TEMPLATE_FUNCTION(GetDurationValue, GetValue<Duration>);
+    ALIAS_TEMPLATE_FUNCTION(GetRateValue, GetValue<Rate>);
     ALIAS_TEMPLATE_FUNCTION(GetChar, GetValue<char>);
     ALIAS_TEMPLATE_FUNCTION(GetStringValue, GetValue<std::string>);
     ALIAS_TEMPLATE_FUNCTION(GetCompositeValue, GetValue<CompositeString>);
 
   private:
-    std::string name_;
+    friend class StreamingParser;
+
+    static constexpr uint32_t kNoIndex = std::numeric_limits<uint32_t>::max();
+
+    /**\n Buffers reused by every parse, so that parsing again with the same
+     * parser does not allocate once they have grown. */
+
+    struct ParseBuffers {
+      std::vector<Token> tokens;
+      std::vector<size_t> used_positions;
+      std::vector<size_t> value_positions;
+      std::vector<size_t> argument_indices;
+      std::vector<Token> positional_args;
+      std::vector<bool> is_used_position;
+      std::vector<bool> is_resolved;
+      std::vector<std::string_view> environment_values;
+      std::vector<std::string_view> path_candidates;
+    };
+
+    std::string_view name_;
     std::vector<ArgumentBuilder*> argument_builders_;
     std::vector<Argument*> arguments_;
+    std::vector<ArgumentTraits> argument_traits_;
+    std::vector<size_t> built_revisions_;
+    std::vector<size_t> positional_indices_;
+    std::vector<std::pair<std::string_view, size_t> > environment_indices_;
     std::vector<std::string_view> allowed_typenames_;
-    std::vector<std::string> allowed_typenames_for_help_;
+    std::vector<std::string_view> allowed_typenames_for_help_;
     std::map<std::string_view, std::map<std::string_view, size_t> > arguments_by_type_;
-    std::map<char, std::string_view> short_to_long_names_;
+    std::array<uint32_t, 256> short_key_indices_;
+    BkTree long_key_tree_;
+    std::vector<uint32_t> flag_slots_;
+    std::map<std::string_view, uint32_t> flag_slots_by_name_;
+    SlotBitset flag_values_;
+    SlotBitset used_arguments_;
+    ConstraintSet constraints_;
+    std::vector<ParsingError> errors_;
     size_t help_index_;
+    ConfigFile config_;
+    ArgvCorpus corpus_;
+    ParseBuffers buffers_;
+    PathCache path_cache_;
 
     bool Parse_(const std::vector<std::string>& args, ConditionalOutput error_output);
 
-    [[nodiscard]] std::vector<std::string_view> GetLongKeys(const std::string_view& current_argument) const;
+    bool GetArgumentIndices(const Token& token, std::vector<size_t>& argument_indices) const;
+
+    void ParsePositionalArguments(std::span<const Token> argv, const std::vector<size_t>& used_positions);
+
+    void PrefetchPaths(std::span<const Token> argv);
+
+    void ApplyFallbackValues();
+
+    [[nodiscard]] uint64_t GetSchemaHash() const;
+
+    void ScanEnvironment(std::vector<std::string_view>& environment_values) const;
 
-    void ParsePositionalArguments(const std::vector<std::string>& argv,
-                                  const std::vector<size_t>& used_positions) const;
+    [[nodiscard]] size_t FindArgumentIndex(const std::string_view& long_key) const;
 
-    [[nodiscard]] bool HandleErrors(ConditionalOutput error_output) const;
+    [[nodiscard]] bool HandleErrors(ConditionalOutput error_output);
+
+    void AddUnknownArgumentError(const Token& token, ConditionalOutput error_output);
 
     void RefreshArguments();
 
+    template<ProperArgumentType T>
+    void RegisterType_();
+
     template<ProperArgumentType T>
     ConcreteArgumentBuilder<T>& AddArgument_(char short_name,
                                              const std::string_view& long_name,
                                              const std::string& description);
 
     template<ProperArgumentType T>
+    requires std::copy_constructible<T>
     T GetValue_(const std::string_view& long_name, size_t index) const;
+
+    template<ProperArgumentType T>
+    const ConcreteArgument<T>& GetArgument_(const std::string_view& long_name) const;
 };
 
 template<ProperArgumentType... Args>
 ArgParser::ArgParser(const std::string& name, ArgumentTypes<Args...> types) {
-  name_ = name;
+  name_ = StringPool::Intern(name);
   allowed_typenames_ =
   {
     typeid(std::string).name(), typeid(CompositeString).name(), typeid(int16_t).name(), typeid(int32_t).name(),
@@ -137,13 +268,14 @@ ArgParser::ArgParser(const std::string& name, ArgumentTypes<Args...> types) {
 
   for (const std::string_view& type_name : types.GetTypenames()) {
     allowed_typenames_.emplace_back(type_name);
-    allowed_typenames_for_help_.emplace_back(type_name);
+    allowed_typenames_for_help_.emplace_back(StringPool::Intern(type_name));
   }
 
   argument_builders_ = {};
   arguments_ = {};
   arguments_by_type_ = {};
-  short_to_long_names_ = {};
+  short_key_indices_.fill(kNoIndex);
+  flag_slots_ = {};
 
   for (const std::string_view& type_name : allowed_typenames_) {
     arguments_by_type_[type_name] = {};
@@ -165,37 +297,78 @@ ConcreteArgumentBuilder<T>& ArgParser::AddArgument(const std::string_view& long_
 }
 
 template<ProperArgumentType T>
+requires std::copy_constructible<T>
 T ArgParser::GetValue(const std::string_view& long_name, size_t index) const {
   return GetValue_<T>(long_name, index);
 }
 
+template<ProperArgumentType T>
+void ArgParser::RegisterType_() {
+  constexpr std::string_view kHelpName = GetOnDemandTypeName<T>();
+
+  if constexpr (!kHelpName.empty()) {
+    if (arguments_by_type_.try_emplace(typeid(T).name()).second) {
+      allowed_typenames_.emplace_back(typeid(T).name());
+      allowed_typenames_for_help_.emplace_back(kHelpName);
+    }
+  }
+}
+
 template<ProperArgumentType T>
 ConcreteArgumentBuilder<T>& ArgParser::AddArgument_(char short_name,
                                                     const std::string_view& long_name,
                                                     const std::string& description) {
+  RegisterType_<T>();
   std::map<std::string_view, size_t>& t_arguments = arguments_by_type_.at(typeid(T).name());
+  const std::string_view interned_name = StringPool::Intern(long_name);
 
   if (short_name != kBadChar) {
-    short_to_long_names_[short_name] = long_name;
+    short_key_indices_[static_cast<unsigned char>(short_name)] = static_cast<uint32_t>(argument_builders_.size());
   }
 
-  t_arguments[long_name] = argument_builders_.size();
-  auto* argument_builder = new ConcreteArgumentBuilder<T>(short_name, long_name, description);
+  if constexpr (std::is_same_v<T, bool>) {
+    flag_slots_.push_back(static_cast<uint32_t>(flag_values_.GetSize()));
+    flag_slots_by_name_[interned_name] = flag_slots_.back();
+    flag_values_.Resize(flag_values_.GetSize() + 1);
+  } else {
+    flag_slots_.push_back(kNoIndex);
+  }
+
+  t_arguments[interned_name] = argument_builders_.size();
+  auto* argument_builder = new ConcreteArgumentBuilder<T>(short_name, interned_name, description);
   argument_builders_.push_back(argument_builder);
 
   return *argument_builder;
 }
 
 template<ProperArgumentType T>
+requires (!std::is_same_v<T, bool>)
+const T& ArgParser::GetValueReference(const std::string_view& long_name, size_t index) const {
+  return GetArgument_<T>(long_name).GetValueReference(index);
+}
+
+template<ProperArgumentType T>
+requires (!std::is_same_v<T, bool>)
+std::span<const T> ArgParser::GetValues(const std::string_view& long_name) const {
+  return GetArgument_<T>(long_name).GetValues();
+}
+
+template<ProperArgumentType T>
+requires std::copy_constructible<T>
 T ArgParser::GetValue_(const std::string_view& long_name, size_t index) const {
+  return GetArgument_<T>(long_name).GetValue(index);
+}
+
+template<ProperArgumentType T>
+const ConcreteArgument<T>& ArgParser::GetArgument_(const std::string_view& long_name) const {
   const std::map<std::string_view, size_t>& t_arguments = arguments_by_type_.at(typeid(T).name());
   const size_t argument_index = t_arguments.at(long_name);
-  const auto* argument = static_cast<ConcreteArgument<T>*>(arguments_.at(argument_index));
-  return argument->GetValue(index);
+  return *static_cast<const ConcreteArgument<T>*>(arguments_.at(argument_index));
 }
 
 template<ProperArgumentType T>
 void ArgumentParser::ArgParser::SetAliasForType(const std::string& alias) {
+  RegisterType_<T>();
   const auto it = std::ranges::find(allowed_typenames_, typeid(T).name());
 
   if (it == allowed_typenames_.end()) {
@@ -213,7 +386,7 @@ void ArgumentParser::ArgParser::SetAliasForType(const std::string& alias) {
     ++alias_end_it;
   }
 
-  *output_it = std::string(alias.begin(), alias_end_it);
+  *output_it = StringPool::Intern(std::string_view(alias.begin(), alias_end_it));
 }
 
 static_assert(ProperArgumentType<int8_t>);
@@ -231,6 +404,10 @@ static_assert(ProperArgumentType<bool>);
 static_assert(ProperArgumentType<char>);
 static_assert(ProperArgumentType<std::string>);
 static_assert(ProperArgumentType<CompositeString>);
+static_assert(ProperArgumentType<Size>);
+static_assert(ProperArgumentType<Duration>);
+static_assert(ProperArgumentType<Rate>);
+static_assert(ProperArgumentType<MappedArray<float>>);
 } // namespace ArgumentParser
 
 #endif // ARGPARSER_HPP_
@@ -1,16 +1,77 @@
 #ifndef ARGPARSERCONCEPTS_HPP_
 #define ARGPARSERCONCEPTS_HPP_
 
-#include <iostream>
 #include <concepts>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+#ifdef ARGPARSER_NO_IOSTREAM
+
+/**\n Without iostreams values are rendered by FormatValue, so argument types
+ * are not required to be writeable to a stream. Values are moved, never
+ * copied, so move-only types are allowed. */
+
+template<typename T>
+concept ProperArgumentType = std::is_default_constructible_v<T> && std::is_move_constructible_v<T>
+    && std::is_move_assignable_v<T>;
+
+#else
+
+#include <ostream>
 
 template<typename T>
 concept Writeable = requires(T t, std::ostream& os) {
   { os << t } -> std::same_as<std::ostream&>;
 };
 
+/**\n Values are moved, never copied, so move-only types are allowed; copying
+ * accessors such as GetValue and StoreValue require a copyable type. */
+
+template<typename T>
+concept ProperArgumentType = std::is_default_constructible_v<T> && std::is_move_constructible_v<T>
+    && std::is_move_assignable_v<T> && Writeable<T>;
+
+#endif
+
+namespace ArgumentParser {
+
+/**\n Customization point for ExportState: values of the types for which it is
+ * true are copied byte by byte. It holds for arithmetic types and enums; a
+ * specialization may opt in a trivially copyable type that holds no pointers
+ * (a std::string_view or a raw pointer would not survive the transfer). */
+
+template<typename T>
+struct RawSerializable : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T>> {};
+
+}
+
+template<typename T>
+concept BinarySerializable = (ArgumentParser::RawSerializable<T>::value && std::is_trivially_copyable_v<T>)
+    || std::derived_from<T, std::string>;
+
+/**\n Types whose values can be deduplicated with a hash set. */
+
+template<typename T>
+concept Hashable = requires(const T& value) {
+  { std::hash<T>{}(value) } -> std::convertible_to<size_t>;
+  { value == value } -> std::convertible_to<bool>;
+};
+
+/**\n Containers that StoreValues can fill besides std::vector: sequences
+ * with push_back (std::deque, std::pmr::vector, small vectors) and sets with
+ * insert (std::set, std::unordered_set). */
+
+template<typename C, typename T>
+concept ValueContainer = std::same_as<typename C::value_type, T> && requires(C container, const T& value) {
+  container.clear();
+} && (requires(C container, const T& value) { container.push_back(value); } ||
+    requires(C container, const T& value) { container.insert(value); });
+
 template<typename T>
-concept ProperArgumentType = std::is_default_constructible_v<T> && std::is_copy_constructible_v<T>
-    && std::is_copy_assignable_v<T> && Writeable<T>;
+concept PathBacked = requires(T value, const T const_value, const std::string& path) {
+  { value.Open(path) } -> std::same_as<bool>;
+  { const_value.GetPath() } -> std::convertible_to<std::string>;
+};
 
 #endif //ARGPARSERCONCEPTS_HPP_
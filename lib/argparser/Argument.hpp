@@ -1,11 +1,16 @@
 #ifndef ARGUMENT_H_
 #define ARGUMENT_H_
 
+#include <algorithm>
+#include <cstdint>
+#include <span>
 #include <string>
 #include <string_view>
+#include <typeinfo>
 #include <vector>
 #include <functional>
 
+#include "Token.hpp"
 #include "lib/argparser/basic/BasicFunctions.hpp"
 
 class CompositeString : public std::string {
@@ -29,13 +34,25 @@ enum class ArgumentParsingStatus {
   kSuccess
 };
 
+/**\n This enumeration sets what a map argument does with a key that it has
+ * already received: keeps the last value, keeps the first one or fails. */
+
+enum class DuplicateKeys {
+  kLastWins,
+  kFirstWins,
+  kError
+};
+
 /** \n This structure represents a single information unit.
- * Contains all required parameters for all argument types. */
+ * Contains all required parameters for all argument types.
+ * All strings are interned in the StringPool. Parsing reads only the
+ * ArgumentTraits compiled from it, the rest is used by help, completion,
+ * constraints and value checks. */
 
 struct ArgumentInformation {
   char short_key = kBadChar;
   std::string_view long_key;
-  std::string description;
+  std::string_view description;
   std::string_view type;
   size_t minimum_values = 0;
   bool is_multi_value = false;
@@ -43,23 +60,139 @@ struct ArgumentInformation {
   bool has_store_values = false;
   bool has_store_value = false;
   bool has_default = false;
+  bool has_is_good = false;
+  char delimiter = kBadChar;
+  std::string_view environment_variable;
+  std::vector<std::string_view> excluded_keys;
+  std::vector<std::string_view> required_keys;
+  std::string_view group;
+  bool is_group_required = false;
+  size_t parallel_chunk = 0;
+  bool has_store_map = false;
+  bool is_unique = false;
+  DuplicateKeys duplicate_keys = DuplicateKeys::kLastWins;
   std::function<bool(std::string&)> validate = [](std::string& value_string) -> bool { return true; };
   std::function<bool(std::string&)> is_good = [](std::string& value_string) -> bool { return true; };
 };
 
+/**\n This function checks if the check function of an argument is the given
+ * plain function, e.g. IsRegularFile. */
+
+inline bool IsValidatorFunction(const std::function<bool(std::string&)>& function,
+                                bool (*validator)(std::string&)) {
+  const auto* target = function.target<bool (*)(std::string&)>();
+  return target != nullptr && *target == validator;
+}
+
+/**\n This structure holds the fields of ArgumentInformation that parsing
+ * reads for every argument, packed into 8 bytes so that a table of them for
+ * all arguments stays dense. It is compiled when an argument is built. */
+
+struct ArgumentTraits {
+  enum Flag : uint16_t {
+    kMultiValue = 1 << 0,
+    kPositional = 1 << 1,
+    kStoreValues = 1 << 2,
+    kStoreValue = 1 << 3,
+    kDefault = 1 << 4,
+    kIsGood = 1 << 5,
+    kEnvironment = 1 << 6,
+    kPathCheck = 1 << 7,
+    kFlag = 1 << 8,
+    kComposite = 1 << 9,
+    kParallel = 1 << 10,
+    kMap = 1 << 11,
+    kUnique = 1 << 12
+  };
+
+  uint32_t minimum_values = 0;
+  uint16_t flags = 0;
+  char short_key = kBadChar;
+  char delimiter = kBadChar;
+
+  ArgumentTraits() = default;
+
+  explicit ArgumentTraits(const ArgumentInformation& info) {
+    const auto is_path_check = [](const std::function<bool(std::string&)>& function) {
+      return IsValidatorFunction(function, &IsRegularFile) || IsValidatorFunction(function, &IsDirectory);
+    };
+
+    minimum_values = static_cast<uint32_t>(std::min<size_t>(info.minimum_values, UINT32_MAX));
+    short_key = info.short_key;
+    delimiter = info.delimiter;
+    Set(kMultiValue, info.is_multi_value);
+    Set(kPositional, info.is_positional);
+    Set(kStoreValues, info.has_store_values);
+    Set(kStoreValue, info.has_store_value);
+    Set(kDefault, info.has_default);
+    Set(kIsGood, info.has_is_good);
+    Set(kEnvironment, !info.environment_variable.empty());
+    Set(kPathCheck, is_path_check(info.is_good) || is_path_check(info.validate));
+    Set(kFlag, info.type == typeid(bool).name());
+    Set(kComposite, info.type == typeid(CompositeString).name());
+    Set(kParallel, info.parallel_chunk != 0 && info.is_multi_value && !info.has_store_map);
+    Set(kMap, info.has_store_map);
+    Set(kUnique, info.is_unique);
+  }
+
+  [[nodiscard]] bool Has(Flag flag) const {
+    return (flags & flag) != 0;
+  }
+
+  void Set(Flag flag, bool value) {
+    flags = static_cast<uint16_t>(value ? (flags | flag) : (flags & ~flag));
+  }
+};
+
+static_assert(sizeof(ArgumentTraits) == 8);
+
+/**\n This structure represents the memory used by a parser, broken down by
+ * components. All values are in bytes; the sizes of heap blocks and tree
+ * nodes are estimated without allocator overhead. */
+
+struct MemoryUsageReport {
+  size_t parser = 0;
+  size_t builders = 0;
+  size_t arguments = 0;
+  size_t stored_values = 0;
+  size_t lookup_tables = 0;
+  size_t type_names = 0;
+
+  [[nodiscard]] size_t Total() const {
+    return parser + builders + arguments + stored_values + lookup_tables + type_names;
+  }
+};
+
+/**\n This function returns the size of the heap block used by a string, zero
+ * if the string fits into the small string buffer. */
+
+inline size_t GetHeapSize(const std::string& value) {
+  return value.capacity() > std::string().capacity() ? value.capacity() + 1 : 0;
+}
+
 class Argument {
  public:
   virtual ~Argument() = default;
-  virtual std::vector<size_t> ValidateArgument(const std::vector<std::string>& argv, size_t position) = 0;
+
+  /**\n This method obtains the values of the argument starting from the
+   * position, appends all positions it used and returns the last of them. */
+
+  virtual size_t ValidateArgument(std::span<const Token> argv, size_t position,
+                                  std::vector<size_t>& used_positions) = 0;
+
   virtual bool CheckLimit() = 0;
   [[nodiscard]] virtual ArgumentParsingStatus GetValueStatus() const = 0;
   [[nodiscard]] virtual const std::string_view& GetType() const = 0;
   [[nodiscard]] virtual const ArgumentInformation& GetInfo() const = 0;
+  [[nodiscard]] virtual const ArgumentTraits& GetTraits() const = 0;
   [[nodiscard]] virtual size_t GetUsedValues() const = 0;
   virtual void ClearStored() = 0;
+  virtual bool ExportValues(std::string& output) const = 0;
+  virtual bool ImportValues(std::string_view& input) = 0;
+  virtual void AddMemoryUsage(MemoryUsageReport& report) const = 0;
 
  protected:
-  virtual size_t ObtainValue(const std::vector<std::string>& argv, std::string& value_string,
+  virtual size_t ObtainValue(std::span<const Token> argv, std::string& value_string,
                              std::vector<size_t>& used_values, size_t position) = 0;
 };
 
@@ -10,7 +10,19 @@ class ArgumentBuilder {
   virtual ~ArgumentBuilder() = default;
   [[nodiscard]] virtual const ArgumentInformation& GetInfo() const = 0;
   [[nodiscard]] virtual std::string GetDefaultValue() const = 0;
+  virtual void AddMemoryUsage(MemoryUsageReport& report) const = 0;
   virtual Argument* build() = 0;
+
+  /**\n The revision changes with every method that sets the information of
+   * the argument, so the parser rebuilds only the arguments whose builders
+   * have changed since the previous parse. */
+
+  [[nodiscard]] size_t GetRevision() const {
+    return revision_;
+  }
+
+ protected:
+  size_t revision_ = 0;
 };
 
 } // namespace ArgumentParser
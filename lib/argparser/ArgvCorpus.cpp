@@ -0,0 +1,155 @@
+#include <cstring>
+
+#include "ArgvCorpus.hpp"
+#include "lib/argparser/basic/BinaryIO.hpp"
+
+namespace {
+
+constexpr size_t kHeaderSize = sizeof(ArgumentParser::ArgvCorpus::kCorpusMagic) + sizeof(uint32_t);
+
+}
+
+ArgumentParser::ArgvCorpus::~ArgvCorpus() {
+  StopCapture();
+}
+
+bool ArgumentParser::ArgvCorpus::StartCapture(const std::string& path, size_t sample_period) {
+  StopCapture();
+  capture_file_ = std::fopen(path.c_str(), "a+b");
+
+  if (capture_file_ == nullptr) {
+    return false;
+  }
+
+  /* A new file gets the header, an existing one is continued only if it is
+   * a corpus of the same version. */
+
+  char header[kHeaderSize];
+  std::fseek(capture_file_, 0, SEEK_SET);
+  const size_t header_size = std::fread(header, 1, kHeaderSize, capture_file_);
+  std::fseek(capture_file_, 0, SEEK_END);
+
+  if (header_size == 0) {
+    std::string new_header(kCorpusMagic, sizeof(kCorpusMagic));
+    WriteBinary(new_header, kCorpusVersion);
+
+    if (std::fwrite(new_header.data(), 1, new_header.size(), capture_file_) != new_header.size()) {
+      StopCapture();
+      return false;
+    }
+  } else {
+    uint32_t version = 0;
+    std::memcpy(&version, header + sizeof(kCorpusMagic), sizeof(version));
+
+    if (header_size != kHeaderSize || std::memcmp(header, kCorpusMagic, sizeof(kCorpusMagic)) != 0 ||
+        version != kCorpusVersion) {
+      StopCapture();
+      return false;
+    }
+  }
+
+  sample_period_ = sample_period == 0 ? 1 : sample_period;
+  capture_counter_ = 0;
+
+  return true;
+}
+
+void ArgumentParser::ArgvCorpus::StopCapture() {
+  if (capture_file_ != nullptr) {
+    std::fclose(capture_file_);
+    capture_file_ = nullptr;
+  }
+}
+
+bool ArgumentParser::ArgvCorpus::IsCapturing() const {
+  return capture_file_ != nullptr;
+}
+
+void ArgumentParser::ArgvCorpus::Capture(const std::vector<std::string>& args) {
+  if (capture_file_ == nullptr || capture_counter_++ % sample_period_ != 0) {
+    return;
+  }
+
+  /* The command line is written with a single call, so the stream never
+   * holds a part of it when the process ends. */
+
+  record_.clear();
+  WriteBinary(record_, static_cast<uint32_t>(args.size()));
+
+  for (const std::string& arg : args) {
+    WriteBinary(record_, static_cast<uint32_t>(arg.size()));
+    record_ += arg;
+  }
+
+  std::fwrite(record_.data(), 1, record_.size(), capture_file_);
+}
+
+bool ArgumentParser::ArgvCorpus::Read(const std::string& path) {
+  Clear();
+
+  if (!file_.Open(path)) {
+    return false;
+  }
+
+  std::string_view data(file_.GetData() == nullptr ? "" : file_.GetData(), file_.GetSize());
+  uint32_t version = 0;
+
+  if (data.size() < kHeaderSize || std::memcmp(data.data(), kCorpusMagic, sizeof(kCorpusMagic)) != 0) {
+    Clear();
+    return false;
+  }
+
+  data.remove_prefix(sizeof(kCorpusMagic));
+  ReadBinary(data, version);
+
+  if (version != kCorpusVersion) {
+    Clear();
+    return false;
+  }
+
+  command_line_offsets_.push_back(0);
+
+  while (!data.empty()) {
+    uint32_t arguments_count = 0;
+    size_t read_arguments = 0;
+
+    if (!ReadBinary(data, arguments_count)) {
+      break;
+    }
+
+    for (; read_arguments < arguments_count; ++read_arguments) {
+      uint32_t size = 0;
+
+      if (!ReadBinary(data, size) || size > data.size()) {
+        break;
+      }
+
+      arguments_.push_back(data.substr(0, size));
+      data.remove_prefix(size);
+    }
+
+    if (read_arguments != arguments_count) {
+      arguments_.resize(command_line_offsets_.back());
+      break;
+    }
+
+    command_line_offsets_.push_back(arguments_.size());
+  }
+
+  return true;
+}
+
+void ArgumentParser::ArgvCorpus::Clear() {
+  arguments_.clear();
+  command_line_offsets_.clear();
+  file_.Close();
+}
+
+size_t ArgumentParser::ArgvCorpus::GetSize() const {
+  return command_line_offsets_.empty() ? 0 : command_line_offsets_.size() - 1;
+}
+
+std::span<const std::string_view> ArgumentParser::ArgvCorpus::GetCommandLine(size_t index) const {
+  return std::span<const std::string_view>(arguments_).subspan(
+      command_line_offsets_[index], command_line_offsets_[index + 1] - command_line_offsets_[index]);
+}
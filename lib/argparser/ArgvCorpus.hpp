@@ -0,0 +1,62 @@
+#ifndef ARGVCORPUS_HPP_
+#define ARGVCORPUS_HPP_
+
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "lib/argparser/basic/MappedFile.hpp"
+
+namespace ArgumentParser {
+
+/**\n This class captures the command lines passed to a parser into a binary
+ * corpus file and reads such files back, so that parsing can be measured on
+ * real command lines. The file starts with a magic and a version, then every
+ * command line is stored as the number of its arguments followed by the
+ * arguments, each prefixed with its size (all numbers are uint32_t). Capture
+ * appends to an existing corpus. A read corpus is memory-mapped and all
+ * arguments are views into it. */
+
+class ArgvCorpus {
+ public:
+  static constexpr char kCorpusMagic[4] = {'A', 'P', 'C', 'R'};
+  static constexpr uint32_t kCorpusVersion = 1;
+
+  ArgvCorpus() = default;
+  ArgvCorpus(const ArgvCorpus& other) = delete;
+  ArgvCorpus& operator=(const ArgvCorpus& other) = delete;
+  ~ArgvCorpus();
+
+  /**\n Every sample_period-th command line passed to Capture is written,
+   * starting with the first one. */
+
+  bool StartCapture(const std::string& path, size_t sample_period = 1);
+  void StopCapture();
+  [[nodiscard]] bool IsCapturing() const;
+  void Capture(const std::vector<std::string>& args);
+
+  /**\n A command line cut off at the end of the file, as left by a process
+   * stopped while writing, is ignored. */
+
+  bool Read(const std::string& path);
+  void Clear();
+
+  [[nodiscard]] size_t GetSize() const;
+  [[nodiscard]] std::span<const std::string_view> GetCommandLine(size_t index) const;
+
+ private:
+  std::FILE* capture_file_ = nullptr;
+  size_t sample_period_ = 1;
+  size_t capture_counter_ = 0;
+  std::string record_;
+  MappedFile file_;
+  std::vector<std::string_view> arguments_;
+  std::vector<size_t> command_line_offsets_;
+};
+
+}
+
+#endif //ARGVCORPUS_HPP_
@@ -3,7 +3,7 @@
 #include "ConcreteArgument.hpp"
 
 template<>
-size_t ArgumentParser::ConcreteArgument<int16_t>::ObtainValue(const std::vector<std::string>& argv,
+size_t ArgumentParser::ConcreteArgument<int16_t>::ObtainValue(std::span<const Token> argv,
                                                                      std::string& value_string,
                                                                      std::vector<size_t>& used_values,
                                                                      size_t position) {
@@ -14,18 +14,18 @@ size_t ArgumentParser::ConcreteArgument<int16_t>::ObtainValue(const std::vector<
 
   if (end == value_string.c_str() || *end != '\0' ||
       ((pre_value <= std::numeric_limits<int16_t>::min() || pre_value >= std::numeric_limits<int16_t>::max()) &&
-          errno == ERANGE) || !info_.is_good(value_string)) {
+          errno == ERANGE) || !IsGood(value_string)) {
     errno = save_errno;
     value_status_ = ArgumentParsingStatus::kInvalidArgument;
   } else {
-    value_ = static_cast<int16_t>(pre_value);
+    *value_ = static_cast<int16_t>(pre_value);
   }
 
   return position;
 }
 
 template<>
-size_t ArgumentParser::ConcreteArgument<int32_t>::ObtainValue(const std::vector<std::string>& argv,
+size_t ArgumentParser::ConcreteArgument<int32_t>::ObtainValue(std::span<const Token> argv,
                                                                      std::string& value_string,
                                                                      std::vector<size_t>& used_values,
                                                                      size_t position) {
@@ -36,18 +36,18 @@ size_t ArgumentParser::ConcreteArgument<int32_t>::ObtainValue(const std::vector<
 
   if (end == value_string.c_str() || *end != '\0' ||
       ((pre_value <= std::numeric_limits<int32_t>::min() || pre_value >= std::numeric_limits<int32_t>::max()) &&
-          errno == ERANGE) || !info_.is_good(value_string)) {
+          errno == ERANGE) || !IsGood(value_string)) {
     errno = save_errno;
     value_status_ = ArgumentParsingStatus::kInvalidArgument;
   } else {
-    value_ = static_cast<int32_t>(pre_value);
+    *value_ = static_cast<int32_t>(pre_value);
   }
 
   return position;
 }
 
 template<>
-size_t ArgumentParser::ConcreteArgument<int64_t>::ObtainValue(const std::vector<std::string>& argv,
+size_t ArgumentParser::ConcreteArgument<int64_t>::ObtainValue(std::span<const Token> argv,
                                                                      std::string& value_string,
                                                                      std::vector<size_t>& used_values,
                                                                      size_t position) {
@@ -58,18 +58,18 @@ size_t ArgumentParser::ConcreteArgument<int64_t>::ObtainValue(const std::vector<
 
   if (end == value_string.c_str() || *end != '\0' ||
       ((pre_value <= std::numeric_limits<int64_t>::min() || pre_value >= std::numeric_limits<int64_t>::max()) &&
-          errno == ERANGE) || !info_.is_good(value_string)) {
+          errno == ERANGE) || !IsGood(value_string)) {
     errno = save_errno;
     value_status_ = ArgumentParsingStatus::kInvalidArgument;
   } else {
-    value_ = pre_value;
+    *value_ = pre_value;
   }
 
   return position;
 }
 
 template<>
-size_t ArgumentParser::ConcreteArgument<uint16_t>::ObtainValue(const std::vector<std::string>& argv,
+size_t ArgumentParser::ConcreteArgument<uint16_t>::ObtainValue(std::span<const Token> argv,
                                                                       std::string& value_string,
                                                                       std::vector<size_t>& used_values,
                                                                       size_t position) {
@@ -80,18 +80,18 @@ size_t ArgumentParser::ConcreteArgument<uint16_t>::ObtainValue(const std::vector
 
   if (end == value_string.c_str() || *end != '\0' ||
       ((pre_value <= std::numeric_limits<uint16_t>::min() || pre_value >= std::numeric_limits<uint16_t>::max()) &&
-          errno == ERANGE) || !info_.is_good(value_string)) {
+          errno == ERANGE) || !IsGood(value_string)) {
     errno = save_errno;
     value_status_ = ArgumentParsingStatus::kInvalidArgument;
   } else {
-    value_ = static_cast<uint16_t>(pre_value);
+    *value_ = static_cast<uint16_t>(pre_value);
   }
 
   return position;
 }
 
 template<>
-size_t ArgumentParser::ConcreteArgument<uint32_t>::ObtainValue(const std::vector<std::string>& argv,
+size_t ArgumentParser::ConcreteArgument<uint32_t>::ObtainValue(std::span<const Token> argv,
                                                                       std::string& value_string,
                                                                       std::vector<size_t>& used_values,
                                                                       size_t position) {
@@ -102,18 +102,18 @@ size_t ArgumentParser::ConcreteArgument<uint32_t>::ObtainValue(const std::vector
 
   if (end == value_string.c_str() || *end != '\0' ||
       ((pre_value <= std::numeric_limits<uint32_t>::min() || pre_value >= std::numeric_limits<uint32_t>::max()) &&
-          errno == ERANGE) || !info_.is_good(value_string)) {
+          errno == ERANGE) || !IsGood(value_string)) {
     errno = save_errno;
     value_status_ = ArgumentParsingStatus::kInvalidArgument;
   } else {
-    value_ = static_cast<uint32_t>(pre_value);
+    *value_ = static_cast<uint32_t>(pre_value);
   }
 
   return position;
 }
 
 template<>
-size_t ArgumentParser::ConcreteArgument<uint64_t>::ObtainValue(const std::vector<std::string>& argv,
+size_t ArgumentParser::ConcreteArgument<uint64_t>::ObtainValue(std::span<const Token> argv,
                                                                       std::string& value_string,
                                                                       std::vector<size_t>& used_values,
                                                                       size_t position) {
@@ -124,18 +124,18 @@ size_t ArgumentParser::ConcreteArgument<uint64_t>::ObtainValue(const std::vector
 
   if (end == value_string.c_str() || *end != '\0' ||
       ((pre_value <= std::numeric_limits<uint64_t>::min() || pre_value >= std::numeric_limits<uint64_t>::max()) &&
-          errno == ERANGE) || !info_.is_good(value_string)) {
+          errno == ERANGE) || !IsGood(value_string)) {
     errno = save_errno;
     value_status_ = ArgumentParsingStatus::kInvalidArgument;
   } else {
-    value_ = pre_value;
+    *value_ = pre_value;
   }
 
   return position;
 }
 
 template<>
-size_t ArgumentParser::ConcreteArgument<float>::ObtainValue(const std::vector<std::string>& argv,
+size_t ArgumentParser::ConcreteArgument<float>::ObtainValue(std::span<const Token> argv,
                                                                    std::string& value_string,
                                                                    std::vector<size_t>& used_values,
                                                                    size_t position) {
@@ -146,18 +146,18 @@ size_t ArgumentParser::ConcreteArgument<float>::ObtainValue(const std::vector<st
 
   if (end == value_string.c_str() || *end != '\0' ||
       ((pre_value <= std::numeric_limits<float>::min() || pre_value >= std::numeric_limits<float>::max()) &&
-          errno == ERANGE) || !info_.is_good(value_string)) {
+          errno == ERANGE) || !IsGood(value_string)) {
     errno = save_errno;
     value_status_ = ArgumentParsingStatus::kInvalidArgument;
   } else {
-    value_ = pre_value;
+    *value_ = pre_value;
   }
 
   return position;
 }
 
 template<>
-size_t ArgumentParser::ConcreteArgument<double>::ObtainValue(const std::vector<std::string>& argv,
+size_t ArgumentParser::ConcreteArgument<double>::ObtainValue(std::span<const Token> argv,
                                                                     std::string& value_string,
                                                                     std::vector<size_t>& used_values,
                                                                     size_t position) {
@@ -168,18 +168,18 @@ size_t ArgumentParser::ConcreteArgument<double>::ObtainValue(const std::vector<s
 
   if (end == value_string.c_str() || *end != '\0' ||
       ((pre_value <= std::numeric_limits<double>::min() || pre_value >= std::numeric_limits<double>::max()) &&
-          errno == ERANGE) || !info_.is_good(value_string)) {
+          errno == ERANGE) || !IsGood(value_string)) {
     errno = save_errno;
     value_status_ = ArgumentParsingStatus::kInvalidArgument;
   } else {
-    value_ = pre_value;
+    *value_ = pre_value;
   }
 
   return position;
 }
 
 template<>
-size_t ArgumentParser::ConcreteArgument<long double>::ObtainValue(const std::vector<std::string>& argv,
+size_t ArgumentParser::ConcreteArgument<long double>::ObtainValue(std::span<const Token> argv,
                                                                          std::string& value_string,
                                                                          std::vector<size_t>& used_values,
                                                                          size_t position) {
@@ -190,25 +190,46 @@ size_t ArgumentParser::ConcreteArgument<long double>::ObtainValue(const std::vec
 
   if (end == value_string.c_str() || *end != '\0' ||
       ((pre_value <= std::numeric_limits<long double>::min() || pre_value >= std::numeric_limits<long double>::max()) &&
-          errno == ERANGE) || !info_.is_good(value_string)) {
+          errno == ERANGE) || !IsGood(value_string)) {
     errno = save_errno;
     value_status_ = ArgumentParsingStatus::kInvalidArgument;
   } else {
-    value_ = pre_value;
+    *value_ = pre_value;
   }
 
   return position;
 }
 
+/**\n This macro defines the parsing method for a type of values with units. */
+
+#define AddUnitValueType(Type, ParsingFunction) \
+template<> \
+size_t ArgumentParser::ConcreteArgument<Type>::ObtainValue(std::span<const Token> argv, \
+                                                           std::string& value_string, \
+                                                           std::vector<size_t>& used_values, \
+                                                           size_t position) { \
+  if (!ParsingFunction(value_string, *value_) || !IsGood(value_string)) { \
+    value_status_ = ArgumentParsingStatus::kInvalidArgument; \
+  } \
+  \
+  return position; \
+}
+
+AddUnitValueType(ArgumentParser::Size, ParseSize)
+AddUnitValueType(ArgumentParser::Duration, ParseDuration)
+AddUnitValueType(ArgumentParser::Rate, ParseRate)
+
+#undef AddUnitValueType
+
 template<>
-size_t ArgumentParser::ConcreteArgument<bool>::ObtainValue(const std::vector<std::string>& argv,
+size_t ArgumentParser::ConcreteArgument<bool>::ObtainValue(std::span<const Token> argv,
                                                                   std::string& value_string,
                                                                   std::vector<size_t>& used_values,
                                                                   size_t position) {
   if (value_string == "0" || value_string == "false") {
-    value_ = false;
+    *value_ = false;
   } else if (value_string == "1" || value_string == "true") {
-    value_ = true;
+    *value_ = true;
   } else {
     value_status_ = ArgumentParsingStatus::kInvalidArgument;
   }
@@ -217,13 +238,13 @@ size_t ArgumentParser::ConcreteArgument<bool>::ObtainValue(const std::vector<std
 }
 
 template<>
-size_t ArgumentParser::ConcreteArgument<char>::ObtainValue(const std::vector<std::string>& argv,
+size_t ArgumentParser::ConcreteArgument<char>::ObtainValue(std::span<const Token> argv,
                                                                   std::string& value_string,
                                                                   std::vector<size_t>& used_values,
                                                                   size_t position) {
   if (value_string[0] != '\\') {
-    if (value_string.size() == 1 && info_.is_good(value_string)) {
-      value_ = value_string[0];
+    if (value_string.size() == 1 && IsGood(value_string)) {
+      *value_ = value_string[0];
     } else {
       value_status_ = ArgumentParsingStatus::kInvalidArgument;
     }
@@ -233,51 +254,51 @@ size_t ArgumentParser::ConcreteArgument<char>::ObtainValue(const std::vector<std
 
   switch (value_string[1]) {
     case 'b': {
-      value_ = '\b';
+      *value_ = '\b';
       break;
     }
     case 'f': {
-      value_ = '\f';
+      *value_ = '\f';
       break;
     }
     case 'n': {
-      value_ = '\n';
+      *value_ = '\n';
       break;
     }
     case 'r': {
-      value_ = '\r';
+      *value_ = '\r';
       break;
     }
     case 't': {
-      value_ = '\t';
+      *value_ = '\t';
       break;
     }
     case '"': {
-      value_ = '\"';
+      *value_ = '\"';
       break;
     }
     case '\'': {
-      value_ = '\'';
+      *value_ = '\'';
       break;
     }
     case '0': {
-      value_ = '\0';
+      *value_ = '\0';
       break;
     }
     case '\\': {
-      value_ = '\\';
+      *value_ = '\\';
       break;
     }
     case 'v': {
-      value_ = '\v';
+      *value_ = '\v';
       break;
     }
     case 'a': {
-      value_ = '\a';
+      *value_ = '\a';
       break;
     }
     case '?': {
-      value_ = '\?';
+      *value_ = '\?';
       break;
     }
     case 'x': {
@@ -293,7 +314,7 @@ size_t ArgumentParser::ConcreteArgument<char>::ObtainValue(const std::vector<std
         errno = save_errno;
         value_status_ = ArgumentParsingStatus::kInvalidArgument;
       } else {
-        value_ = static_cast<char>(pre_value);
+        *value_ = static_cast<char>(pre_value);
       }
 
       break;
@@ -312,7 +333,7 @@ size_t ArgumentParser::ConcreteArgument<char>::ObtainValue(const std::vector<std
           errno = save_errno;
           value_status_ = ArgumentParsingStatus::kInvalidArgument;
         } else {
-          value_ = static_cast<char>(pre_value);
+          *value_ = static_cast<char>(pre_value);
         }
       } else {
         value_status_ = ArgumentParsingStatus::kInvalidArgument;
@@ -322,8 +343,8 @@ size_t ArgumentParser::ConcreteArgument<char>::ObtainValue(const std::vector<std
     }
   }
 
-  if (!info_.is_good(value_string)) {
-    value_ = default_value_;
+  if (!IsGood(value_string)) {
+    *value_ = default_value_;
     value_status_ = ArgumentParsingStatus::kInvalidArgument;
   }
 
@@ -331,12 +352,12 @@ size_t ArgumentParser::ConcreteArgument<char>::ObtainValue(const std::vector<std
 }
 
 template<>
-size_t ArgumentParser::ConcreteArgument<std::string>::ObtainValue(const std::vector<std::string>& argv,
+size_t ArgumentParser::ConcreteArgument<std::string>::ObtainValue(std::span<const Token> argv,
                                                                          std::string& value_string,
                                                                          std::vector<size_t>& used_values,
                                                                          size_t position) {
-  if (info_.is_good(value_string)) {
-    value_ = value_string;
+  if (IsGood(value_string)) {
+    *value_ = value_string;
   } else {
     value_status_ = ArgumentParsingStatus::kInvalidArgument;
   }
@@ -345,7 +366,7 @@ size_t ArgumentParser::ConcreteArgument<std::string>::ObtainValue(const std::vec
 }
 
 template<>
-size_t ArgumentParser::ConcreteArgument<CompositeString>::ObtainValue(const std::vector<std::string>& argv,
+size_t ArgumentParser::ConcreteArgument<CompositeString>::ObtainValue(std::span<const Token> argv,
                                                                              std::string& value_string,
                                                                              std::vector<size_t>& used_values,
                                                                              size_t position) {
@@ -354,14 +375,14 @@ size_t ArgumentParser::ConcreteArgument<CompositeString>::ObtainValue(const std:
     return position;
   }
 
-  size_t current = position + (info_.is_good(value_string) ? 0 : 1);
+  size_t current = position + (IsGood(value_string) ? 0 : 1);
 
-  while (current < argv.size() && argv[current][0] != '-' &&
+  while (current < argv.size() && argv[current].IsValue() &&
       value_status_ != ArgumentParsingStatus::kInvalidArgument &&
       value_string.size() < 256 &&
-      !info_.is_good(value_string)) {
+      !IsGood(value_string)) {
     value_string += " ";
-    value_string += argv[current];
+    value_string += argv[current].text;
 
     if (!info_.validate(value_string)) {
       value_status_ = ArgumentParsingStatus::kInvalidArgument;
@@ -371,8 +392,8 @@ size_t ArgumentParser::ConcreteArgument<CompositeString>::ObtainValue(const std:
     ++current;
   }
 
-  if (info_.validate(value_string) && info_.is_good(value_string)) {
-    value_ = value_string;
+  if (info_.validate(value_string) && IsGood(value_string)) {
+    *value_ = value_string;
     position = current;
 
     for (size_t i = used_values.back(); i <= current; ++i) {
@@ -384,3 +405,33 @@ size_t ArgumentParser::ConcreteArgument<CompositeString>::ObtainValue(const std:
 
   return position;
 }
+
+/**\n This macro defines the parsing method for ConcreteArgument<MappedArray<Type>>:
+ * the value string is a path to the file which is mapped into memory. */
+
+#define AddMappedArrayType(Type) \
+template<> \
+size_t ArgumentParser::ConcreteArgument<ArgumentParser::MappedArray<Type>>::ObtainValue( \
+    std::span<const Token> argv, \
+    std::string& value_string, \
+    std::vector<size_t>& used_values, \
+    size_t position) { \
+  if (!IsGood(value_string) || !value_->Open(value_string)) { \
+    value_status_ = ArgumentParsingStatus::kInvalidArgument; \
+  } \
+  \
+  return position; \
+}
+
+AddMappedArrayType(float)
+AddMappedArrayType(double)
+AddMappedArrayType(int8_t)
+AddMappedArrayType(int16_t)
+AddMappedArrayType(int32_t)
+AddMappedArrayType(int64_t)
+AddMappedArrayType(uint8_t)
+AddMappedArrayType(uint16_t)
+AddMappedArrayType(uint32_t)
+AddMappedArrayType(uint64_t)
+
+#undef AddMappedArrayType
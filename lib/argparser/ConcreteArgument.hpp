@@ -1,11 +1,28 @@
 #ifndef CONCRETEARGUMENT_HPP_
 #define CONCRETEARGUMENT_HPP_
 
+#include <atomic>
+#include <optional>
+#include <span>
+
 #include "Argument.hpp"
 #include "ArgParserConcepts.hpp"
+#include "MappedArray.hpp"
+#include "UnitValues.hpp"
+#include "ValueSink.hpp"
+#include "lib/argparser/basic/BinaryIO.hpp"
+#include "lib/argparser/basic/FlatHashMap.hpp"
+#include "lib/argparser/basic/FlatIndexSet.hpp"
+#include "lib/argparser/basic/NumericParsing.hpp"
+#include "lib/argparser/basic/Parallel.hpp"
+#include "lib/argparser/basic/PathCache.hpp"
+#include "lib/argparser/basic/SlotBitset.hpp"
 
 namespace ArgumentParser {
 
+/**\n The result of a parsing function for AddArgumentType. The value is
+ * moved into its storage, so the type may be move-only. */
+
 template<ProperArgumentType T>
 struct NonMemberParsingResult {
   bool success = true;
@@ -19,50 +36,139 @@ class ConcreteArgument final : public Argument {
   ConcreteArgument(const ArgumentInformation& info,
                    const T& default_value,
                    T* stored_value,
-                   std::vector<T>* stored_values);
-  [[nodiscard]] T GetValue(size_t index) const;
-  std::vector<size_t> ValidateArgument(const std::vector<std::string>& argv, size_t position) override;
+                   std::vector<T>* stored_values,
+                   FlatHashMap<T>* stored_map = nullptr,
+                   ValueSink<T>* stored_sink = nullptr);
+  [[nodiscard]] T GetValue(size_t index) const requires std::copy_constructible<T>;
+  [[nodiscard]] const T& GetValueReference(size_t index) const requires (!std::is_same_v<T, bool>);
+  [[nodiscard]] std::span<const T> GetValues() const requires (!std::is_same_v<T, bool>);
+  size_t ValidateArgument(std::span<const Token> argv, size_t position,
+                          std::vector<size_t>& used_positions) override;
   bool CheckLimit() override;
   [[nodiscard]] ArgumentParsingStatus GetValueStatus() const override;
   [[nodiscard]] const std::string_view& GetType() const override;
   [[nodiscard]] const ArgumentInformation& GetInfo() const override;
+  [[nodiscard]] const ArgumentTraits& GetTraits() const override;
   [[nodiscard]] size_t GetUsedValues() const override;
   void ClearStored() override;
+  bool ExportValues(std::string& output) const override;
+  bool ImportValues(std::string_view& input) override;
+  void AddMemoryUsage(MemoryUsageReport& report) const override;
+
+  /**\n A flag keeps its value in a slot of the bitset of its parser. The slot
+   * is set to the default value here and when the argument is cleared, and
+   * to every received value while parsing; a flag with StoreValues keeps its
+   * values in the vector too, and its slot holds the first of them. */
+
+  void BindFlagSlot(SlotBitset& flag_values, size_t slot) requires std::is_same_v<T, bool>;
  protected:
-  size_t ObtainValue(const std::vector<std::string>& argv, std::string& value_string,
+  size_t ObtainValue(std::span<const Token> argv, std::string& value_string,
                      std::vector<size_t>& used_values, size_t position) override;
 
  private:
-  ArgumentInformation info_;
+  void ObtainDelimitedValues(std::span<const Token> argv, std::string_view values_string,
+                             std::vector<size_t>& used_values, size_t position);
+
+  size_t ObtainNextValue(std::span<const Token> argv, std::string& value_string,
+                         std::vector<size_t>& used_values, size_t position);
+
+  size_t ObtainValuesInParallel(std::span<const Token> argv, std::vector<size_t>& used_values,
+                                size_t position);
+
+  void ObtainMapEntry(std::span<const Token> argv, std::string_view entry_string,
+                      std::vector<size_t>& used_values, size_t position);
+
+  void RemoveDuplicates(size_t begin);
+
+  void StoreLastValue();
+
+  void AppendToSink();
+
+  [[nodiscard]] bool IsGood(std::string& value_string) const;
+
+  [[nodiscard]] bool IsSlotFlag() const;
+
+  const ArgumentTraits traits_;
+  const ArgumentInformation& info_;
   ArgumentParsingStatus value_status_;
   size_t value_counter_;
-  T value_;
-  T default_value_;
+  T* value_;
+  const T& default_value_;
   T* stored_value_;
   std::vector<T>* stored_values_;
+  FlatHashMap<T>* stored_map_;
+  ValueSink<T>* stored_sink_;
+  size_t sunk_values_;
+  FlatIndexSet unique_values_;
+  SlotBitset* flag_values_;
+  size_t flag_slot_;
 };
 
+/**\n The argument does not copy the information and the default value, it
+ * refers to the ones owned by its builder, which must outlive the argument.
+ * Parsing reads only the traits stored next to the values. Every value is
+ * constructed in place as a new element of the values vector, value_ points
+ * to it while ObtainValue runs. The values of a map argument are
+ * constructed in the entries of the map instead. */
+
 template<ProperArgumentType T>
 ConcreteArgument<T>::ConcreteArgument(const ArgumentInformation& info,
                                       const T& default_value,
                                       T* stored_value,
-                                      std::vector<T>* stored_values) {
-  info_ = info;
-  value_ = default_value;
+                                      std::vector<T>* stored_values,
+                                      FlatHashMap<T>* stored_map,
+                                      ValueSink<T>* stored_sink)
+    : traits_(info), info_(info), default_value_(default_value) {
+  value_ = nullptr;
   value_counter_ = 0;
   value_status_ = ArgumentParsingStatus::kNoArgument;
-  default_value_ = default_value;
   stored_value_ = stored_value;
   stored_values_ = stored_values;
+  stored_map_ = stored_map;
+  stored_sink_ = stored_sink;
+  sunk_values_ = 0;
+  flag_values_ = nullptr;
+  flag_slot_ = 0;
 }
 
+/**\n Without StoreValues the last received value is returned for any index,
+ * or the default value if there is none. */
+
 template<ProperArgumentType T>
-T ConcreteArgument<T>::GetValue(size_t index) const {
-  if (!info_.has_store_values) {
-    return value_;
+T ConcreteArgument<T>::GetValue(size_t index) const requires std::copy_constructible<T> {
+  if constexpr (std::is_same_v<T, bool>) {
+    if (IsSlotFlag()) {
+      return flag_values_->Test(flag_slot_);
+    }
+  }
+
+  if (traits_.Has(ArgumentTraits::kStoreValues)) {
+    return stored_values_->at(index);
+  }
+
+  if (stored_values_->empty()) {
+    return default_value_;
   }
 
-  return stored_values_->at(index);
+  return stored_values_->back();
+}
+
+template<ProperArgumentType T>
+const T& ConcreteArgument<T>::GetValueReference(size_t index) const requires (!std::is_same_v<T, bool>) {
+  if (traits_.Has(ArgumentTraits::kStoreValues)) {
+    return stored_values_->at(index);
+  }
+
+  return stored_values_->empty() ? default_value_ : stored_values_->back();
+}
+
+/**\n Values are returned in the order they were received, whether or not
+ * they are stored in a user vector. std::vector<bool> has no contiguous
+ * storage, so flags are read with GetValue. */
+
+template<ProperArgumentType T>
+std::span<const T> ConcreteArgument<T>::GetValues() const requires (!std::is_same_v<T, bool>) {
+  return {stored_values_->data(), stored_values_->size()};
 }
 
 template<ProperArgumentType T>
@@ -80,6 +186,11 @@ const ArgumentInformation& ConcreteArgument<T>::GetInfo() const {
   return info_;
 }
 
+template<ProperArgumentType T>
+const ArgumentTraits& ConcreteArgument<T>::GetTraits() const {
+  return traits_;
+}
+
 template<ProperArgumentType T>
 size_t ConcreteArgument<T>::GetUsedValues() const {
   return value_counter_;
@@ -87,7 +198,7 @@ size_t ConcreteArgument<T>::GetUsedValues() const {
 
 template<ProperArgumentType T>
 bool ConcreteArgument<T>::CheckLimit() {
-  if (value_counter_ < info_.minimum_values) {
+  if (value_counter_ < traits_.minimum_values) {
     value_status_ = ArgumentParsingStatus::kInsufficientArguments;
     return false;
   }
@@ -99,61 +210,527 @@ bool ConcreteArgument<T>::CheckLimit() {
   return true;
 }
 
+/**\n The argument is reused by the next parse if its builder has not
+ * changed, so it returns to the state it was built in. */
+
 template<ProperArgumentType T>
 void ConcreteArgument<T>::ClearStored() {
   stored_values_->clear();
   value_counter_ = 0;
+  value_status_ = ArgumentParsingStatus::kNoArgument;
+
+  if (stored_map_ != nullptr) {
+    stored_map_->Clear();
+  }
+
+  if (stored_sink_ != nullptr) {
+    stored_sink_->Clear();
+    sunk_values_ = 0;
+  }
+
+  unique_values_.Clear();
 
-  if (stored_value_ != nullptr) {
-    *stored_value_ = default_value_;
+  if constexpr (std::is_copy_assignable_v<T>) {
+    if (stored_value_ != nullptr) {
+      *stored_value_ = default_value_;
+    }
+  }
+
+  if constexpr (std::is_same_v<T, bool>) {
+    if (flag_values_ != nullptr) {
+      flag_values_->Set(flag_slot_, default_value_);
+    }
   }
 }
 
 template<ProperArgumentType T>
-std::vector<size_t> ConcreteArgument<T>::ValidateArgument(const std::vector<std::string>& argv,
-                                                          size_t position) {
-  std::vector<size_t> used_positions;
-  if (stored_values_->empty()) {
+void ConcreteArgument<T>::BindFlagSlot(SlotBitset& flag_values, size_t slot) requires std::is_same_v<T, bool> {
+  flag_values_ = &flag_values;
+  flag_slot_ = slot;
+  flag_values_->Set(flag_slot_, default_value_);
+}
+
+/**\n A flag without StoreValues stores nothing but its slot. */
+
+template<ProperArgumentType T>
+bool ConcreteArgument<T>::IsSlotFlag() const {
+  return std::is_same_v<T, bool> && flag_values_ != nullptr && !traits_.Has(ArgumentTraits::kStoreValues);
+}
+
+/**\n The entries of a map argument are not exported, so a parser with such
+ * an argument has no state to export. */
+
+template<ProperArgumentType T>
+bool ConcreteArgument<T>::ExportValues(std::string& output) const {
+  if constexpr (!BinarySerializable<T> && !PathBacked<T>) {
+    return false;
+  } else {
+    if (traits_.Has(ArgumentTraits::kMap)) {
+      return false;
+    }
+
+    WriteBinary(output, static_cast<uint8_t>(value_status_));
+    WriteBinary(output, static_cast<uint64_t>(value_counter_));
+
+    if constexpr (std::is_same_v<T, bool>) {
+      if (IsSlotFlag()) {
+        WriteBinary(output, static_cast<uint64_t>(value_counter_ != 0));
+
+        if (value_counter_ != 0) {
+          WriteBinary(output, static_cast<uint8_t>(flag_values_->Test(flag_slot_)));
+        }
+
+        return true;
+      }
+    }
+
+    WriteBinary(output, static_cast<uint64_t>(stored_values_->size()));
+
+    if constexpr (std::derived_from<T, std::string>) {
+      for (const T& value : *stored_values_) {
+        WriteBinary(output, static_cast<uint64_t>(value.size()));
+        output += value;
+      }
+    } else if constexpr (PathBacked<T>) {
+      for (const T& value : *stored_values_) {
+        WriteBinary(output, static_cast<uint64_t>(value.GetPath().size()));
+        output += value.GetPath();
+      }
+    } else if constexpr (std::is_same_v<T, bool>) {
+      for (const bool value : *stored_values_) {
+        WriteBinary(output, static_cast<uint8_t>(value));
+      }
+    } else {
+      output.append(reinterpret_cast<const char*>(stored_values_->data()), stored_values_->size() * sizeof(T));
+    }
+
+    return true;
+  }
+}
+
+template<ProperArgumentType T>
+bool ConcreteArgument<T>::ImportValues(std::string_view& input) {
+  if constexpr (!BinarySerializable<T> && !PathBacked<T>) {
+    return false;
+  } else {
+    if (traits_.Has(ArgumentTraits::kMap)) {
+      return false;
+    }
+
+    uint8_t status = 0;
+    uint64_t counter = 0;
+    uint64_t values_count = 0;
+
+    if (!ReadBinary(input, status) || !ReadBinary(input, counter) || !ReadBinary(input, values_count) ||
+        status > static_cast<uint8_t>(ArgumentParsingStatus::kSuccess)) {
+      return false;
+    }
+
+    stored_values_->clear();
+
+    if constexpr (std::derived_from<T, std::string>) {
+      for (uint64_t i = 0; i < values_count; ++i) {
+        uint64_t size = 0;
+
+        if (!ReadBinary(input, size) || size > input.size()) {
+          return false;
+        }
+
+        stored_values_->emplace_back(input.substr(0, size));
+        input.remove_prefix(size);
+      }
+    } else if constexpr (PathBacked<T>) {
+      for (uint64_t i = 0; i < values_count; ++i) {
+        uint64_t size = 0;
+
+        if (!ReadBinary(input, size) || size > input.size() ||
+            !stored_values_->emplace_back().Open(std::string(input.substr(0, size)))) {
+          return false;
+        }
+
+        input.remove_prefix(size);
+      }
+    } else if constexpr (std::is_same_v<T, bool>) {
+      bool flag_value = default_value_;
+
+      for (uint64_t i = 0; i < values_count; ++i) {
+        uint8_t value = 0;
+
+        if (!ReadBinary(input, value)) {
+          return false;
+        }
+
+        if (!IsSlotFlag()) {
+          stored_values_->push_back(value != 0);
+        }
+
+        if (i == 0 || IsSlotFlag()) {
+          flag_value = value != 0;
+        }
+      }
+
+      if (flag_values_ != nullptr) {
+        flag_values_->Set(flag_slot_, flag_value);
+      }
+    } else {
+      if (values_count > input.size() / sizeof(T)) {
+        return false;
+      }
+
+      stored_values_->resize(values_count);
+
+      if (values_count != 0) {
+        std::memcpy(stored_values_->data(), input.data(), values_count * sizeof(T));
+        input.remove_prefix(values_count * sizeof(T));
+      }
+    }
+
+    value_status_ = static_cast<ArgumentParsingStatus>(status);
+    value_counter_ = counter;
+
+    unique_values_.Clear();
+    RemoveDuplicates(0);
+
+    if (!stored_values_->empty() || IsSlotFlag()) {
+      StoreLastValue();
+    }
+
+    AppendToSink();
+
+    return true;
+  }
+}
+
+template<ProperArgumentType T>
+void ConcreteArgument<T>::AddMemoryUsage(MemoryUsageReport& report) const {
+  report.arguments += sizeof(*this);
+}
+
+template<ProperArgumentType T>
+size_t ConcreteArgument<T>::ValidateArgument(std::span<const Token> argv,
+                                             size_t position,
+                                             std::vector<size_t>& used_positions) {
+  const size_t first_used_position = used_positions.size();
+  std::string value_string;
+  const size_t initial_size = stored_values_->size();
+
+  if (value_counter_ == 0) {
     value_status_ = ArgumentParsingStatus::kSuccess;
   }
 
-  while (used_positions.empty() || info_.is_multi_value) {
-    std::string value_string = argv[position];
-    used_positions.push_back(position);
+  /* The value is viewed in the token and copied only to be converted, so
+   * that a map entry copies just the text after its '='. */
 
-    if (argv[position][0] == '-') {
-      const size_t equals_index = argv[position].find('=');
+  while (used_positions.size() == first_used_position || traits_.Has(ArgumentTraits::kMultiValue)) {
+    std::string_view value_view = argv[position].text;
+    used_positions.push_back(position);
 
-      if (equals_index != std::string::npos) {
-        value_string = argv[position].substr(equals_index + 1);
+    if (!argv[position].IsValue()) {
+      if (argv[position].has_value) {
+        value_view = argv[position].value;
       } else if (std::is_same_v<T, bool>) {
-        value_string = "true";
+        value_view = "true";
+      } else if (position + 1 >= argv.size() || argv[position + 1].IsTerminator()) {
+        value_status_ = ArgumentParsingStatus::kInvalidArgument;
+        break;
       } else {
         ++position;
         used_positions.push_back(position);
-        value_string = argv[position];
+        value_view = argv[position].text;
       }
     }
 
-    position = ObtainValue(argv, value_string, used_positions, position);
+    if (traits_.delimiter != kBadChar) {
+      ObtainDelimitedValues(argv, value_view, used_positions, position);
+    } else if (traits_.Has(ArgumentTraits::kMap)) {
+      ObtainMapEntry(argv, value_view, used_positions, position);
+    } else {
+      value_string.assign(value_view);
+      position = ObtainNextValue(argv, value_string, used_positions, position);
+    }
 
     ++position;
-    ++value_counter_;
-
-    stored_values_->push_back(value_);
 
-    if (position >= argv.size() || argv[position][0] == '-') {
+    if (position >= argv.size() || !argv[position].IsValue()) {
       break;
     }
+
+    /* Flags are stored as bits and composite strings consume several tokens,
+     * so only the values of other types are independent of each other. */
+
+    if constexpr (!std::is_same_v<T, bool> && !std::is_same_v<T, CompositeString>) {
+      if (traits_.Has(ArgumentTraits::kParallel) && traits_.delimiter == kBadChar) {
+        position = ObtainValuesInParallel(argv, used_positions, position);
+        break;
+      }
+    }
   }
 
+  RemoveDuplicates(initial_size);
   CheckLimit();
+  StoreLastValue();
+  AppendToSink();
 
-  if (info_.has_store_value) {
-    *stored_value_ = value_;
+  return used_positions.back();
+}
+
+template<ProperArgumentType T>
+size_t ConcreteArgument<T>::ObtainNextValue(std::span<const Token> argv,
+                                            std::string& value_string,
+                                            std::vector<size_t>& used_values,
+                                            size_t position) {
+  /* std::vector<bool> has no addressable elements, so flags are obtained
+   * into a local variable and written to their slot or appended. */
+
+  if constexpr (std::is_same_v<T, bool>) {
+    bool value = default_value_;
+    value_ = &value;
+    position = ObtainValue(argv, value_string, used_values, position);
+
+    if (flag_values_ != nullptr && (IsSlotFlag() || value_counter_ == 0)) {
+      flag_values_->Set(flag_slot_, value);
+    }
+
+    if (!IsSlotFlag()) {
+      stored_values_->push_back(value);
+    }
+  } else {
+    value_ = &stored_values_->emplace_back();
+    position = ObtainValue(argv, value_string, used_values, position);
   }
 
-  return used_positions;
+  value_ = nullptr;
+  ++value_counter_;
+
+  return position;
+}
+
+/**\n This method converts the run of values that starts at the position and
+ * ends before the next option. The store is resized once and each chunk of
+ * the run is converted on its own thread by a separate argument object that
+ * writes directly to the elements of the chunk. The run is invalid if any of
+ * its values is invalid, which does not depend on the order of the chunks.
+ * The path cache of the parse is activated on every thread, and an exception
+ * of any chunk reaches the caller as on the serial path. Returns the position
+ * after the run. */
+
+template<ProperArgumentType T>
+size_t ConcreteArgument<T>::ObtainValuesInParallel(std::span<const Token> argv,
+                                                   std::vector<size_t>& used_values,
+                                                   size_t position) {
+  size_t end = position;
+
+  while (end < argv.size() && argv[end].IsValue()) {
+    used_values.push_back(end);
+    ++end;
+  }
+
+  const size_t offset = stored_values_->size();
+  const size_t count = end - position;
+  std::atomic<bool> is_invalid = false;
+  stored_values_->resize(offset + count);
+  PathCache* const path_cache = PathCache::GetActive();
+
+  ParallelFor(count, info_.parallel_chunk, [&](size_t begin, size_t chunk_end) {
+    std::optional<ScopedPathCache> scoped_path_cache;
+
+    if (path_cache != nullptr) {
+      scoped_path_cache.emplace(*path_cache);
+    }
+
+    ConcreteArgument<T> worker(info_, default_value_, nullptr, stored_values_);
+    std::vector<size_t> chunk_used_values;
+
+    for (size_t i = begin; i < chunk_end; ++i) {
+      std::string value_string(argv[position + i].text);
+      worker.value_ = &(*stored_values_)[offset + i];
+      worker.ObtainValue(argv, value_string, chunk_used_values, position + i);
+    }
+
+    if (worker.value_status_ == ArgumentParsingStatus::kInvalidArgument) {
+      is_invalid = true;
+    }
+  });
+
+  value_counter_ += count;
+
+  if (is_invalid) {
+    value_status_ = ArgumentParsingStatus::kInvalidArgument;
+  }
+
+  return end;
+}
+
+/**\n This method splits a "key=value" entry on its first '=' and converts
+ * the value directly into the entry of the map. An entry without '=' or
+ * with an empty key is invalid. A repeated key fails with DuplicateKeys::kError,
+ * otherwise its value is converted and checked anyway and either replaces
+ * the stored one (kLastWins) or is dropped (kFirstWins). */
+
+template<ProperArgumentType T>
+void ConcreteArgument<T>::ObtainMapEntry(std::span<const Token> argv,
+                                         std::string_view entry_string,
+                                         std::vector<size_t>& used_values,
+                                         size_t position) {
+  const size_t equals_index = entry_string.find('=');
+
+  if (equals_index == std::string_view::npos || equals_index == 0) {
+    value_status_ = ArgumentParsingStatus::kInvalidArgument;
+    return;
+  }
+
+  std::string value_string(entry_string.substr(equals_index + 1));
+  auto [value, is_inserted] = stored_map_->TryEmplace(entry_string.substr(0, equals_index));
+  std::optional<T> dropped_value;
+
+  if (!is_inserted) {
+    if (info_.duplicate_keys == DuplicateKeys::kError) {
+      value_status_ = ArgumentParsingStatus::kInvalidArgument;
+      return;
+    }
+
+    if (info_.duplicate_keys == DuplicateKeys::kFirstWins) {
+      value_ = &dropped_value.emplace();
+    } else {
+      value = T();
+      value_ = &value;
+    }
+  } else {
+    value_ = &value;
+  }
+
+  ObtainValue(argv, value_string, used_values, position);
+  value_ = nullptr;
+  ++value_counter_;
+}
+
+/**\n This method drops the values received from the index on that are equal
+ * to earlier ones and moves the rest together, keeping their order. Values
+ * are converted before they are compared, so "0x10" and "16" are equal
+ * integers; MultiValue limits count the received values. */
+
+template<ProperArgumentType T>
+void ConcreteArgument<T>::RemoveDuplicates(size_t begin) {
+  if constexpr (Hashable<T>) {
+    if (!traits_.Has(ArgumentTraits::kUnique)) {
+      return;
+    }
+
+    std::vector<T>& values = *stored_values_;
+    size_t end = begin;
+
+    for (size_t i = begin; i < values.size(); ++i) {
+      const auto is_equal = [&values, i](size_t index) { return values[index] == values[i]; };
+
+      if (!unique_values_.Insert(std::hash<T>{}(values[i]), end, is_equal)) {
+        continue;
+      }
+
+      if (end != i) {
+        values[end] = std::move(values[i]);
+      }
+
+      ++end;
+    }
+
+    values.erase(values.begin() + static_cast<ptrdiff_t>(end), values.end());
+  }
+}
+
+/**\n The value of StoreValue is the only copy made while parsing, so it is
+ * available only for copyable types. */
+
+template<ProperArgumentType T>
+void ConcreteArgument<T>::StoreLastValue() {
+  if constexpr (std::is_copy_assignable_v<T>) {
+    if (!traits_.Has(ArgumentTraits::kStoreValue)) {
+      return;
+    }
+
+    if constexpr (std::is_same_v<T, bool>) {
+      if (IsSlotFlag()) {
+        *stored_value_ = flag_values_->Test(flag_slot_);
+        return;
+      }
+    }
+
+    if (stored_values_->empty()) {
+      *stored_value_ = default_value_;
+    } else {
+      *stored_value_ = stored_values_->back();
+    }
+  }
+}
+
+template<ProperArgumentType T>
+void ConcreteArgument<T>::AppendToSink() {
+  if (stored_sink_ != nullptr) {
+    stored_sink_->Append(*stored_values_, sunk_values_);
+    sunk_values_ = stored_values_->size();
+  }
+}
+
+/**\n The check is called only if it was set with AddIsGood, so that the
+ * function object is not touched for the other arguments. */
+
+template<ProperArgumentType T>
+bool ConcreteArgument<T>::IsGood(std::string& value_string) const {
+  return !traits_.Has(ArgumentTraits::kIsGood) || info_.is_good(value_string);
+}
+
+template<ProperArgumentType T>
+void ConcreteArgument<T>::ObtainDelimitedValues(std::span<const Token> argv,
+                                                std::string_view values_string,
+                                                std::vector<size_t>& used_values,
+                                                size_t position) {
+  /* Decimal lists of integers without a custom check are converted directly
+   * into the store; anything else (hexadecimal, octal, custom types) goes
+   * through ObtainValue one element at a time. */
+
+  if constexpr (std::integral<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>) {
+    const size_t initial_size = stored_values_->size();
+
+    if (!traits_.Has(ArgumentTraits::kIsGood) && !traits_.Has(ArgumentTraits::kMap) && ParseIntegerList(values_string, traits_.delimiter, *stored_values_)) {
+      value_counter_ += stored_values_->size() - initial_size;
+      return;
+    }
+  }
+
+  while (true) {
+    const size_t delimiter_index = values_string.find(traits_.delimiter);
+
+    if (traits_.Has(ArgumentTraits::kMap)) {
+      ObtainMapEntry(argv, values_string.substr(0, delimiter_index), used_values, position);
+    } else {
+      std::string value_string(values_string.substr(0, delimiter_index));
+      ObtainNextValue(argv, value_string, used_values, position);
+    }
+
+    if (delimiter_index == std::string_view::npos) {
+      break;
+    }
+
+    values_string.remove_prefix(delimiter_index + 1);
+  }
+}
+
+/**\n This function calls a parsing function of AddArgumentType. A function
+ * bool(std::string_view, T&) writes the value directly into its storage, a
+ * function returning NonMemberParsingResult<T> has its value moved there. */
+
+template<ProperArgumentType T, typename ParsingFunction>
+bool ApplyParsingFunction(ParsingFunction&& parsing_function, std::string& value_string, T& value) {
+  if constexpr (std::is_invocable_r_v<bool, ParsingFunction, std::string_view, T&>) {
+    return parsing_function(std::string_view(value_string), value);
+  } else {
+    NonMemberParsingResult<T> result = parsing_function(value_string);
+
+    if (result.success) {
+      value = std::move(result.value);
+    }
+
+    return result.success;
+  }
 }
 
 }
@@ -161,19 +738,18 @@ std::vector<size_t> ConcreteArgument<T>::ValidateArgument(const std::vector<std:
 #define PassArgumentTypes(...) ArgumentParser::ArgumentTypes<__VA_ARGS__>{}
 
 /**\n This macro adds a definition of the parsing method for ConcreteArgument<Type>. \n
- * Note that this macro creates such definition for types with simple logics. */
+ * Note that this macro creates such definition for types with simple logics. \n
+ * ParsingFunction is either NonMemberParsingResult<Type>(const std::string&)
+ * (or std::string_view) or bool(std::string_view, Type&); the latter parses
+ * the value in place and suits types that are expensive to move. */
 
 #define AddArgumentType(Type, ParsingFunction) \
 template<> \
-size_t ArgumentParser::ConcreteArgument<Type>::ObtainValue(const std::vector<std::string>& argv, \
+size_t ArgumentParser::ConcreteArgument<Type>::ObtainValue(std::span<const Token> argv, \
 std::string& value_string, \
 std::vector<size_t>& used_values, \
 size_t position) { \
-  NonMemberParsingResult<Type> result = ParsingFunction(value_string); \
-  \
-  if (result.success) {\
-    value_ = result.value; \
-  } else { \
+  if (!ApplyParsingFunction<Type>(ParsingFunction, value_string, *value_)) { \
     value_status_ = ArgumentParsingStatus::kInvalidArgument;\
   }\
   \
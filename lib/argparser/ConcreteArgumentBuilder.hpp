@@ -1,11 +1,15 @@
 #ifndef CONCRETEARGUMENTBUILDER_HPP_
 #define CONCRETEARGUMENTBUILDER_HPP_
 
-#include <sstream>
-
+#include <algorithm>
+#include <climits>
+#include <memory>
 #include "ArgumentBuilder.hpp"
 #include "ConcreteArgument.hpp"
 #include "ArgParserConcepts.hpp"
+#include "ValueFormatter.hpp"
+#include "ValueSink.hpp"
+#include "lib/argparser/basic/StringPool.hpp"
 
 namespace ArgumentParser {
 
@@ -17,61 +21,132 @@ class ConcreteArgumentBuilder final : public ArgumentBuilder {
   ConcreteArgumentBuilder(char short_name, const std::string_view& long_name, const std::string& description) {
     info_ = ArgumentInformation();
     info_.short_key = short_name;
-    info_.long_key = long_name;
-    info_.description = description;
+    info_.long_key = StringPool::Intern(long_name);
+    info_.description = StringPool::Intern(description);
     info_.type = typeid(T).name();
     default_value_ = T();
     stored_value_ = nullptr;
     stored_values_ = nullptr;
-    was_created_temp_vector_ = false;
+    stored_map_ = nullptr;
   }
 
   ConcreteArgumentBuilder(const ConcreteArgumentBuilder& other) = delete;
 
   ConcreteArgumentBuilder& operator=(const ConcreteArgumentBuilder& other) = delete;
 
-  ~ConcreteArgumentBuilder() override {
-    if (was_created_temp_vector_) {
-      delete stored_values_;
-    }
-  }
-
   ConcreteArgumentBuilder& MultiValue(size_t min = 0) {
     info_.is_multi_value = true;
     info_.minimum_values = min;
+    ++revision_;
     return *this;
   }
 
   ConcreteArgumentBuilder& Positional() {
     info_.is_positional = true;
+    ++revision_;
     return *this;
   }
 
-  ConcreteArgumentBuilder& StoreValue(T& value) {
+  ConcreteArgumentBuilder& StoreValue(T& value) requires std::is_copy_assignable_v<T> {
     info_.has_store_value = true;
     stored_value_ = &value;
+    ++revision_;
     return *this;
   }
 
   ConcreteArgumentBuilder& StoreValues(std::vector<T>& values) {
     info_.has_store_values = true;
     stored_values_ = &values;
+    ++revision_;
+    return *this;
+  }
+
+  /**\n Values for any other container are parsed into the vector of the
+   * argument and copied to the container, so the type must be copyable. */
+
+  template<ValueContainer<T> Container>
+  ConcreteArgumentBuilder& StoreValues(Container& values) requires std::copy_constructible<T> {
+    info_.has_store_values = true;
+    stored_sink_ = std::make_unique<ContainerValueSink<T, Container>>(values);
+    ++revision_;
+    return *this;
+  }
+
+  /**\n Repeated values are dropped as they arrive, the first occurrence of
+   * each value is kept in its place. */
+
+  ConcreteArgumentBuilder& Unique() requires Hashable<T> {
+    info_.is_unique = true;
+    ++revision_;
+    return *this;
+  }
+
+  /**\n Every value of the argument is a "key=value" pair: the text after the
+   * first '=' is converted to T and stored under the key in the map, which
+   * is cleared before each parse. */
+
+  ConcreteArgumentBuilder& StoreMap(FlatHashMap<T>& map, DuplicateKeys duplicate_keys = DuplicateKeys::kLastWins) {
+    info_.has_store_map = true;
+    info_.duplicate_keys = duplicate_keys;
+    stored_map_ = &map;
+    ++revision_;
     return *this;
   }
 
   ConcreteArgumentBuilder& Default(T value) {
     info_.has_default = true;
-    default_value_ = value;
+    default_value_ = std::move(value);
+    ++revision_;
+    return *this;
+  }
+
+  ConcreteArgumentBuilder& Delimited(char delimiter = ',') {
+    info_.delimiter = delimiter;
+    ++revision_;
+    return *this;
+  }
+
+  ConcreteArgumentBuilder& ParallelConversion(size_t minimum_chunk = 16384) {
+    info_.parallel_chunk = std::max<size_t>(minimum_chunk, 1);
+    ++revision_;
+    return *this;
+  }
+
+  ConcreteArgumentBuilder& FromEnvironment(const std::string& variable) {
+    info_.environment_variable = StringPool::Intern(variable);
+    ++revision_;
+    return *this;
+  }
+
+  ConcreteArgumentBuilder& Excludes(const std::string_view& long_name) {
+    info_.excluded_keys.push_back(StringPool::Intern(long_name));
+    ++revision_;
+    return *this;
+  }
+
+  ConcreteArgumentBuilder& Requires(const std::string_view& long_name) {
+    info_.required_keys.push_back(StringPool::Intern(long_name));
+    ++revision_;
+    return *this;
+  }
+
+  ConcreteArgumentBuilder& OneOf(const std::string_view& group, bool is_required = false) {
+    info_.group = StringPool::Intern(group);
+    info_.is_group_required = is_required;
+    ++revision_;
     return *this;
   }
 
   ConcreteArgumentBuilder& AddValidate(const std::function<bool(std::string&)>& validate) {
     info_.validate = validate;
+    ++revision_;
     return *this;
   }
 
   ConcreteArgumentBuilder& AddIsGood(const std::function<bool(std::string&)>& is_good) {
     info_.is_good = is_good;
+    info_.has_is_good = true;
+    ++revision_;
     return *this;
   }
 
@@ -84,12 +159,35 @@ class ConcreteArgumentBuilder final : public ArgumentBuilder {
       info_.minimum_values = 1;
     }
 
-    if (!info_.has_store_values && !was_created_temp_vector_) {
-      stored_values_ = new std::vector<T>;
-      was_created_temp_vector_ = true;
+    if (stored_values_ == nullptr) {
+      stored_values_ = &values_;
+    }
+
+    return new ConcreteArgument<T>(info_, default_value_, stored_value_, stored_values_, stored_map_,
+                                   stored_sink_.get());
+  }
+
+  void AddMemoryUsage(MemoryUsageReport& report) const override {
+    report.builders += sizeof(*this);
+    report.builders += (info_.excluded_keys.capacity() + info_.required_keys.capacity()) * sizeof(std::string_view);
+
+    if constexpr (std::derived_from<T, std::string>) {
+      report.builders += GetHeapSize(default_value_);
     }
 
-    return new ConcreteArgument<T>(info_, default_value_, stored_value_, stored_values_);
+    if (stored_values_ == &values_) {
+      if constexpr (std::is_same_v<T, bool>) {
+        report.stored_values += stored_values_->capacity() / CHAR_BIT;
+      } else {
+        report.stored_values += stored_values_->capacity() * sizeof(T);
+      }
+
+      if constexpr (std::derived_from<T, std::string>) {
+        for (const T& value : *stored_values_) {
+          report.stored_values += GetHeapSize(value);
+        }
+      }
+    }
   }
 
   [[nodiscard]] const ArgumentInformation& GetInfo() const override {
@@ -97,9 +195,7 @@ class ConcreteArgumentBuilder final : public ArgumentBuilder {
   }
 
   [[nodiscard]] std::string GetDefaultValue() const override {
-    std::ostringstream stream;
-    stream << default_value_;
-    return stream.str();
+    return FormatValue(default_value_);
   }
 
  private:
@@ -107,7 +203,9 @@ class ConcreteArgumentBuilder final : public ArgumentBuilder {
   T default_value_;
   T* stored_value_;
   std::vector<T>* stored_values_;
-  bool was_created_temp_vector_;
+  FlatHashMap<T>* stored_map_;
+  std::unique_ptr<ValueSink<T>> stored_sink_;
+  std::vector<T> values_;
 };
 
 } // namespace ArgumentParser
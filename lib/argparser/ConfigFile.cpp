@@ -0,0 +1,164 @@
+#include <cstdio>
+#include <cstring>
+
+#include "ConfigFile.hpp"
+#include "lib/argparser/basic/BinaryIO.hpp"
+
+namespace {
+
+constexpr size_t kHeaderSize = sizeof(ArgumentParser::ConfigFile::kSnapshotMagic) + 2 * sizeof(uint32_t);
+constexpr size_t kRecordSize = 4 * sizeof(uint32_t);
+
+std::string_view Trim(std::string_view text) {
+  const size_t begin = text.find_first_not_of(" \t\r");
+
+  if (begin == std::string_view::npos) {
+    return {};
+  }
+
+  const size_t end = text.find_last_not_of(" \t\r");
+
+  return text.substr(begin, end - begin + 1);
+}
+
+}
+
+bool ArgumentParser::ConfigFile::Read(const std::string& path) {
+  Clear();
+
+  if (!file_.Open(path)) {
+    return false;
+  }
+
+  const std::string_view data(file_.GetData() == nullptr ? "" : file_.GetData(), file_.GetSize());
+
+  if (data.size() >= kHeaderSize &&
+      std::memcmp(data.data(), kSnapshotMagic, sizeof(kSnapshotMagic)) == 0) {
+    is_snapshot_ = true;
+    return ParseSnapshot(data);
+  }
+
+  return ParseText(data);
+}
+
+bool ArgumentParser::ConfigFile::WriteSnapshot(const std::string& path) const {
+  /* Layout: magic, version, number of entries, then a table of
+   * (key offset, key size, value offset, value size) records and the string
+   * data. All offsets are counted from the beginning of the file, so the
+   * snapshot does not depend on the address it is mapped to. */
+
+  std::string snapshot(kSnapshotMagic, sizeof(kSnapshotMagic));
+  size_t offset = kHeaderSize + entries_.size() * kRecordSize;
+
+  WriteBinary(snapshot, kSnapshotVersion);
+  WriteBinary(snapshot, static_cast<uint32_t>(entries_.size()));
+
+  for (const auto& [key, value] : entries_) {
+    WriteBinary(snapshot, static_cast<uint32_t>(offset));
+    WriteBinary(snapshot, static_cast<uint32_t>(key.size()));
+    offset += key.size();
+    WriteBinary(snapshot, static_cast<uint32_t>(offset));
+    WriteBinary(snapshot, static_cast<uint32_t>(value.size()));
+    offset += value.size();
+  }
+
+  for (const auto& [key, value] : entries_) {
+    snapshot += key;
+    snapshot += value;
+  }
+
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+
+  if (file == nullptr) {
+    return false;
+  }
+
+  const bool is_written = std::fwrite(snapshot.data(), 1, snapshot.size(), file) == snapshot.size();
+
+  return std::fclose(file) == 0 && is_written;
+}
+
+void ArgumentParser::ConfigFile::Clear() {
+  entries_.clear();
+  file_.Close();
+  is_snapshot_ = false;
+}
+
+bool ArgumentParser::ConfigFile::IsSnapshot() const {
+  return is_snapshot_;
+}
+
+const std::vector<ArgumentParser::ConfigFile::Entry>& ArgumentParser::ConfigFile::GetEntries() const {
+  return entries_;
+}
+
+bool ArgumentParser::ConfigFile::ParseText(std::string_view text) {
+  while (!text.empty()) {
+    const size_t line_end = text.find('\n');
+    const std::string_view line = Trim(text.substr(0, line_end));
+    text = (line_end == std::string_view::npos) ? std::string_view{} : text.substr(line_end + 1);
+
+    if (line.empty() || line[0] == '#' || line[0] == ';') {
+      continue;
+    }
+
+    const size_t equals_index = line.find('=');
+
+    if (equals_index == std::string_view::npos) {
+      entries_.clear();
+      return false;
+    }
+
+    const std::string_view key = Trim(line.substr(0, equals_index));
+    std::string_view value = Trim(line.substr(equals_index + 1));
+
+    if (value.size() >= 2 && (value[0] == '"' || value[0] == '\'') && value.back() == value[0]) {
+      value = value.substr(1, value.size() - 2);
+    }
+
+    if (key.empty()) {
+      entries_.clear();
+      return false;
+    }
+
+    entries_.emplace_back(key, value);
+  }
+
+  return true;
+}
+
+bool ArgumentParser::ConfigFile::ParseSnapshot(std::string_view data) {
+  std::string_view header = data.substr(sizeof(kSnapshotMagic));
+  uint32_t version = 0;
+  uint32_t entries_count = 0;
+  ReadBinary(header, version);
+  ReadBinary(header, entries_count);
+
+  if (version != kSnapshotVersion || (data.size() - kHeaderSize) / kRecordSize < entries_count) {
+    return false;
+  }
+
+  entries_.reserve(entries_count);
+  std::string_view records = data.substr(kHeaderSize);
+
+  for (size_t i = 0; i < entries_count; ++i) {
+    uint32_t key_offset = 0;
+    uint32_t key_size = 0;
+    uint32_t value_offset = 0;
+    uint32_t value_size = 0;
+    ReadBinary(records, key_offset);
+    ReadBinary(records, key_size);
+    ReadBinary(records, value_offset);
+    ReadBinary(records, value_size);
+
+    if (static_cast<uint64_t>(key_offset) + key_size > data.size() ||
+        static_cast<uint64_t>(value_offset) + value_size > data.size()) {
+      entries_.clear();
+      return false;
+    }
+
+    entries_.emplace_back(data.substr(key_offset, key_size), data.substr(value_offset, value_size));
+  }
+
+  return true;
+}
@@ -0,0 +1,49 @@
+#ifndef CONFIGFILE_HPP_
+#define CONFIGFILE_HPP_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "lib/argparser/basic/MappedFile.hpp"
+
+namespace ArgumentParser {
+
+/**\n This class stores the values of a configuration file. The file is either
+ * a text file with lines in form "key = value" (lines starting with '#' or ';'
+ * are comments), or a binary snapshot previously written by WriteSnapshot.
+ * In both cases the file is memory-mapped and all entries are views into it,
+ * so a snapshot is used without any parsing besides the bounds checks. */
+
+class ConfigFile {
+ public:
+  using Entry = std::pair<std::string_view, std::string_view>;
+
+  static constexpr char kSnapshotMagic[4] = {'A', 'P', 'C', 'S'};
+  static constexpr uint32_t kSnapshotVersion = 1;
+
+  ConfigFile() = default;
+  ConfigFile(const ConfigFile& other) = delete;
+  ConfigFile& operator=(const ConfigFile& other) = delete;
+
+  bool Read(const std::string& path);
+  [[nodiscard]] bool WriteSnapshot(const std::string& path) const;
+  void Clear();
+
+  [[nodiscard]] bool IsSnapshot() const;
+  [[nodiscard]] const std::vector<Entry>& GetEntries() const;
+
+ private:
+  MappedFile file_;
+  std::vector<Entry> entries_;
+  bool is_snapshot_ = false;
+
+  bool ParseText(std::string_view text);
+  bool ParseSnapshot(std::string_view data);
+};
+
+}
+
+#endif //CONFIGFILE_HPP_
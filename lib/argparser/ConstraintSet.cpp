@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <unordered_map>
+
+#include "ConstraintSet.hpp"
+
+void ArgumentParser::ConstraintSet::Compile(const std::vector<ArgumentBuilder*>& argument_builders) {
+  long_keys_.clear();
+  argument_rules_.clear();
+  group_rules_.clear();
+
+  const bool has_constraints = std::ranges::any_of(argument_builders, [](const ArgumentBuilder* argument_builder) {
+    const ArgumentInformation& info = argument_builder->GetInfo();
+    return !info.excluded_keys.empty() || !info.required_keys.empty() || !info.group.empty();
+  });
+
+  if (!has_constraints) {
+    return;
+  }
+
+  std::unordered_map<std::string_view, size_t> indices;
+
+  for (size_t i = 0; i < argument_builders.size(); ++i) {
+    long_keys_.push_back(argument_builders[i]->GetInfo().long_key);
+    indices.emplace(long_keys_.back(), i);
+  }
+
+  /* Names that do not belong to any argument are ignored. */
+
+  const auto fill_mask = [&](const std::vector<std::string_view>& keys, SlotBitset& mask) {
+    mask.Resize(argument_builders.size());
+
+    for (const std::string_view& key : keys) {
+      const auto it = indices.find(key);
+
+      if (it != indices.end()) {
+        mask.Set(it->second);
+      }
+    }
+  };
+
+  for (size_t i = 0; i < argument_builders.size(); ++i) {
+    const ArgumentInformation& info = argument_builders[i]->GetInfo();
+
+    if (!info.excluded_keys.empty() || !info.required_keys.empty()) {
+      ArgumentRule& rule = argument_rules_.emplace_back();
+      rule.index = i;
+      fill_mask(info.excluded_keys, rule.excluded);
+      fill_mask(info.required_keys, rule.required);
+    }
+
+    if (!info.group.empty()) {
+      auto it = std::ranges::find(group_rules_, info.group, &GroupRule::name);
+
+      if (it == group_rules_.end()) {
+        GroupRule& group_rule = group_rules_.emplace_back();
+        group_rule.name = info.group;
+        group_rule.is_required = false;
+        group_rule.members.Resize(argument_builders.size());
+        it = group_rules_.end() - 1;
+      }
+
+      it->members.Set(i);
+      it->is_required = it->is_required || info.is_group_required;
+    }
+  }
+}
+
+void ArgumentParser::ConstraintSet::Check(const SlotBitset& used_arguments, std::vector<ParsingError>& errors) const {
+  for (const ArgumentRule& rule : argument_rules_) {
+    if (!used_arguments.Test(rule.index)) {
+      continue;
+    }
+
+    const size_t excluded_index = used_arguments.FindFirstCommon(rule.excluded);
+
+    if (excluded_index != SlotBitset::kNoSlot) {
+      errors.push_back({ParsingErrorKind::kExcludedArgument,
+                        std::string(long_keys_[rule.index]),
+                        std::string(long_keys_[excluded_index])});
+    }
+
+    const size_t missing_index = used_arguments.FindFirstMissing(rule.required);
+
+    if (missing_index != SlotBitset::kNoSlot) {
+      errors.push_back({ParsingErrorKind::kMissingRequiredArgument,
+                        std::string(long_keys_[rule.index]),
+                        std::string(long_keys_[missing_index])});
+    }
+  }
+
+  for (const GroupRule& group_rule : group_rules_) {
+    const size_t used_count = used_arguments.CountCommon(group_rule.members);
+
+    if (used_count > 1) {
+      errors.push_back({ParsingErrorKind::kGroupConflict,
+                        std::string(long_keys_[used_arguments.FindFirstCommon(group_rule.members)]),
+                        std::string(group_rule.name)});
+    } else if (used_count == 0 && group_rule.is_required) {
+      errors.push_back({ParsingErrorKind::kMissingGroupArgument, {}, std::string(group_rule.name)});
+    }
+  }
+}
+
+bool ArgumentParser::ConstraintSet::IsEmpty() const {
+  return argument_rules_.empty() && group_rules_.empty();
+}
+
+size_t ArgumentParser::ConstraintSet::GetMemoryUsage() const {
+  size_t memory_usage = long_keys_.capacity() * sizeof(std::string_view) +
+      argument_rules_.capacity() * sizeof(ArgumentRule) + group_rules_.capacity() * sizeof(GroupRule);
+
+  for (const ArgumentRule& rule : argument_rules_) {
+    memory_usage += rule.excluded.GetMemoryUsage() + rule.required.GetMemoryUsage();
+  }
+
+  for (const GroupRule& group_rule : group_rules_) {
+    memory_usage += group_rule.members.GetMemoryUsage();
+  }
+
+  return memory_usage;
+}
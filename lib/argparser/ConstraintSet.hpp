@@ -0,0 +1,45 @@
+#ifndef CONSTRAINTSET_HPP_
+#define CONSTRAINTSET_HPP_
+
+#include <string_view>
+#include <vector>
+
+#include "ArgumentBuilder.hpp"
+#include "ParsingError.hpp"
+#include "lib/argparser/basic/SlotBitset.hpp"
+
+namespace ArgumentParser {
+
+/**\n This class holds the constraints between arguments (Excludes, Requires,
+ * OneOf) compiled into bitmasks over argument indices. Each check is a few
+ * word operations on the set of arguments that received values. */
+
+class ConstraintSet {
+ public:
+  void Compile(const std::vector<ArgumentBuilder*>& argument_builders);
+  void Check(const SlotBitset& used_arguments, std::vector<ParsingError>& errors) const;
+
+  [[nodiscard]] bool IsEmpty() const;
+  [[nodiscard]] size_t GetMemoryUsage() const;
+
+ private:
+  struct ArgumentRule {
+    size_t index;
+    SlotBitset excluded;
+    SlotBitset required;
+  };
+
+  struct GroupRule {
+    std::string_view name;
+    SlotBitset members;
+    bool is_required;
+  };
+
+  std::vector<std::string_view> long_keys_;
+  std::vector<ArgumentRule> argument_rules_;
+  std::vector<GroupRule> group_rules_;
+};
+
+}
+
+#endif //CONSTRAINTSET_HPP_
@@ -0,0 +1,119 @@
+#ifndef MAPPEDARRAY_HPP_
+#define MAPPEDARRAY_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "ValueFormatter.hpp"
+#include "lib/argparser/basic/MappedFile.hpp"
+
+#ifndef ARGPARSER_NO_IOSTREAM
+#include <ostream>
+#endif
+
+namespace ArgumentParser {
+
+/**\n This class represents an argument whose value is a path to a binary file
+ * of raw T values in native byte order. The file is mapped into memory while
+ * parsing and its contents are available as a span without reading or copying.
+ * Copies of the object share the same mapping, which is released with the last
+ * copy. */
+
+template<typename T>
+requires std::is_arithmetic_v<T>
+class MappedArray {
+ public:
+  static constexpr std::string_view kTypeName = [] {
+    if constexpr (std::is_same_v<T, float>) {
+      return "MappedArray<float>";
+    } else if constexpr (std::is_same_v<T, double>) {
+      return "MappedArray<double>";
+    } else if constexpr (std::is_same_v<T, int8_t>) {
+      return "MappedArray<int8>";
+    } else if constexpr (std::is_same_v<T, int16_t>) {
+      return "MappedArray<int16>";
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+      return "MappedArray<int32>";
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+      return "MappedArray<int64>";
+    } else if constexpr (std::is_same_v<T, uint8_t>) {
+      return "MappedArray<uint8>";
+    } else if constexpr (std::is_same_v<T, uint16_t>) {
+      return "MappedArray<uint16>";
+    } else if constexpr (std::is_same_v<T, uint32_t>) {
+      return "MappedArray<uint32>";
+    } else if constexpr (std::is_same_v<T, uint64_t>) {
+      return "MappedArray<uint64>";
+    } else {
+      return "MappedArray";
+    }
+  }();
+
+  MappedArray() = default;
+
+  /**\n This method maps the file and checks that its size is a multiple of
+   * sizeof(T) and its data is suitably aligned for T. On failure the object
+   * is left unchanged. */
+
+  bool Open(const std::string& path) {
+    auto file = std::make_shared<MappedFile>();
+
+    if (!file->Open(path) || file->GetSize() % sizeof(T) != 0 ||
+        reinterpret_cast<uintptr_t>(file->GetData()) % alignof(T) != 0) {
+      return false;
+    }
+
+    file_ = std::move(file);
+    path_ = path;
+
+    return true;
+  }
+
+  [[nodiscard]] std::span<const T> GetSpan() const {
+    if (file_ == nullptr || file_->GetData() == nullptr) {
+      return {};
+    }
+
+    return {reinterpret_cast<const T*>(file_->GetData()), file_->GetSize() / sizeof(T)};
+  }
+
+  [[nodiscard]] size_t GetSize() const {
+    return file_ == nullptr ? 0 : file_->GetSize() / sizeof(T);
+  }
+
+  [[nodiscard]] const std::string& GetPath() const {
+    return path_;
+  }
+
+  [[nodiscard]] bool IsOpen() const {
+    return file_ != nullptr;
+  }
+
+ private:
+  std::shared_ptr<const MappedFile> file_;
+  std::string path_;
+};
+
+template<typename T>
+struct ValueFormatter<MappedArray<T>> {
+  static std::string Format(const MappedArray<T>& array) {
+    return array.GetPath();
+  }
+};
+
+#ifndef ARGPARSER_NO_IOSTREAM
+
+template<typename T>
+std::ostream& operator<<(std::ostream& os, const MappedArray<T>& array) {
+  return os << array.GetPath();
+}
+
+#endif
+
+}
+
+#endif //MAPPEDARRAY_HPP_
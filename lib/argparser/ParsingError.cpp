@@ -0,0 +1,23 @@
+#include "ParsingError.hpp"
+
+std::string ArgumentParser::ParsingError::GetMessage() const {
+  switch (kind) {
+    case ParsingErrorKind::kUnknownArgument:
+      return "Used nonexistent argument: " + argument
+          + (related.empty() ? "" : ", did you mean --" + related + "?") + "\n";
+    case ParsingErrorKind::kInvalidArgument:
+      return "An incorrect value was passed to the --" + argument + " argument.\n";
+    case ParsingErrorKind::kInsufficientArguments:
+      return "Not enough values were passed to argument --" + argument + ".\n";
+    case ParsingErrorKind::kExcludedArgument:
+      return "Argument --" + argument + " cannot be used together with --" + related + ".\n";
+    case ParsingErrorKind::kMissingRequiredArgument:
+      return "Argument --" + argument + " requires --" + related + ".\n";
+    case ParsingErrorKind::kGroupConflict:
+      return "Only one argument of the group " + related + " can be used, got --" + argument + " and others.\n";
+    case ParsingErrorKind::kMissingGroupArgument:
+      return "One argument of the group " + related + " is required.\n";
+  }
+
+  return {};
+}
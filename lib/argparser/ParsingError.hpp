@@ -0,0 +1,34 @@
+#ifndef PARSINGERROR_HPP_
+#define PARSINGERROR_HPP_
+
+#include <string>
+
+namespace ArgumentParser {
+
+enum class ParsingErrorKind {
+  kUnknownArgument,
+  kInvalidArgument,
+  kInsufficientArguments,
+  kExcludedArgument,
+  kMissingRequiredArgument,
+  kGroupConflict,
+  kMissingGroupArgument
+};
+
+/**\n This structure describes a single error of the last parsing. The
+ * argument is the long key of the argument the error refers to (or the
+ * command line token for an unknown argument); related is the long key of
+ * the other argument or the name of the group, if the error has one. For an
+ * unknown long key related is the closest registered long key, if any. */
+
+struct ParsingError {
+  ParsingErrorKind kind;
+  std::string argument;
+  std::string related;
+
+  [[nodiscard]] std::string GetMessage() const;
+};
+
+}
+
+#endif //PARSINGERROR_HPP_
@@ -0,0 +1,205 @@
+#include <algorithm>
+
+#include "StreamingParser.hpp"
+
+ArgumentParser::StreamingParser::StreamingParser(ArgParser& parser,
+                                                 PositionalCallback positional_callback,
+                                                 ConditionalOutput error_output)
+    : parser_(parser), positional_callback_(std::move(positional_callback)), error_output_(error_output) {
+  parser_.RefreshArguments();
+  parser_.path_cache_.Clear();
+}
+
+bool ArgumentParser::StreamingParser::Feed(std::string_view token) {
+  if (is_failed_ || is_stopped_) {
+    return false;
+  }
+
+  /* A deque does not move its elements when it grows, so the token views
+   * into the pending strings stay valid. */
+
+  pending_.emplace_back(token);
+  pending_tokens_.push_back(ClassifyToken(pending_.back()));
+  ProcessPending();
+
+  return !is_failed_ && !is_stopped_;
+}
+
+bool ArgumentParser::StreamingParser::Feed(const std::vector<std::string>& tokens) {
+  for (const std::string& token : tokens) {
+    if (!Feed(token)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool ArgumentParser::StreamingParser::Finish() {
+  is_finishing_ = true;
+  ProcessPending();
+
+  if (is_failed_) {
+    return false;
+  }
+
+  if (!positional_callback_) {
+    ClassifyTokens(positional_values_, tokens_);
+    parser_.ParsePositionalArguments(tokens_, {});
+    positional_values_.clear();
+  }
+
+  parser_.ApplyFallbackValues();
+
+  return parser_.HandleErrors(error_output_);
+}
+
+size_t ArgumentParser::StreamingParser::GetPendingSize() const {
+  return pending_.size() + positional_values_.size();
+}
+
+void ArgumentParser::StreamingParser::ProcessPending() {
+  while (!pending_tokens_.empty() && !is_failed_ && !is_stopped_) {
+    const Token& token = pending_tokens_.front();
+
+    if (token.IsTerminator()) {
+      is_stopped_ = true;
+      PopPending(pending_tokens_.size());
+      return;
+    }
+
+    if (token.IsValue()) {
+      if (!continued_indices_.empty()) {
+        ContinueOption();
+      } else if (!positional_callback_) {
+        positional_values_.push_back(std::move(pending_.front()));
+      } else if (!positional_callback_(token.text)) {
+        is_stopped_ = true;
+      }
+
+      PopPending(1);
+      continue;
+    }
+
+    continued_indices_.clear();
+
+    /* The option is looked up once, later calls only scan the tokens that
+     * have arrived since. */
+
+    if (scanned_tokens_ == 0) {
+      if (token.text.size() == 1) {
+        is_failed_ = true;
+        return;
+      }
+
+      if (!parser_.GetArgumentIndices(token, argument_indices_)) {
+        parser_.AddUnknownArgumentError(token, error_output_);
+        is_failed_ = true;
+        return;
+      }
+
+      scanned_tokens_ = 1;
+    }
+
+    if (!IsOptionReady()) {
+      return;
+    }
+
+    ResolveOption();
+  }
+}
+
+bool ArgumentParser::StreamingParser::IsOptionReady() {
+  /* An option takes the next token as its value if it has no "=", so it is
+   * resolved when this token has arrived. A composite option also takes all
+   * following values up to the next option and waits for them. */
+
+  if (is_finishing_) {
+    return true;
+  }
+
+  const bool has_value = pending_tokens_.front().has_value;
+  size_t required_tokens = 1;
+  bool is_composite = false;
+
+  for (const size_t argument_index : argument_indices_) {
+    const ArgumentTraits& traits = parser_.argument_traits_[argument_index];
+
+    if (!has_value && !traits.Has(ArgumentTraits::kFlag)) {
+      required_tokens = 2;
+    }
+
+    if (traits.Has(ArgumentTraits::kComposite)) {
+      is_composite = true;
+    }
+  }
+
+  if (pending_tokens_.size() < required_tokens) {
+    return false;
+  }
+
+  if (!is_composite) {
+    return true;
+  }
+
+  for (scanned_tokens_ = std::max(scanned_tokens_, required_tokens); scanned_tokens_ < pending_tokens_.size();
+       ++scanned_tokens_) {
+    if (!pending_tokens_[scanned_tokens_].IsValue()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ArgumentParser::StreamingParser::ResolveOption() {
+  /* The pending tokens are terminated as in Parse, the option is validated
+   * from the first position and all tokens up to the farthest one used are
+   * dropped. If the option used every pending token, its repeated arguments
+   * take the values that arrive next. */
+
+  tokens_.assign(pending_tokens_.begin(), pending_tokens_.end());
+  tokens_.push_back(ClassifyToken("--"));
+  size_t last_position = 0;
+
+  for (const size_t argument_index : argument_indices_) {
+    used_positions_.clear();
+    last_position = std::max(last_position, parser_.arguments_[argument_index]->ValidateArgument(tokens_, 0,
+                                                                                                 used_positions_));
+  }
+
+  const size_t used_tokens = std::min(last_position + 1, pending_tokens_.size());
+
+  if (used_tokens == pending_tokens_.size()) {
+    for (const size_t argument_index : argument_indices_) {
+      if (parser_.argument_traits_[argument_index].Has(ArgumentTraits::kMultiValue)) {
+        continued_indices_.push_back(argument_index);
+      }
+    }
+  }
+
+  PopPending(used_tokens);
+}
+
+void ArgumentParser::StreamingParser::ContinueOption() {
+  /* ValidateArgument started at a value takes it as the next value of the
+   * run, as if it had followed the previous values in one command line. */
+
+  tokens_.clear();
+  tokens_.push_back(pending_tokens_.front());
+  tokens_.push_back(ClassifyToken("--"));
+
+  for (const size_t argument_index : continued_indices_) {
+    used_positions_.clear();
+    parser_.arguments_[argument_index]->ValidateArgument(tokens_, 0, used_positions_);
+  }
+}
+
+void ArgumentParser::StreamingParser::PopPending(size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    pending_tokens_.pop_front();
+    pending_.pop_front();
+  }
+
+  scanned_tokens_ = 0;
+}
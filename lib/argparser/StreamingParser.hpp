@@ -0,0 +1,71 @@
+#ifndef STREAMINGPARSER_HPP_
+#define STREAMINGPARSER_HPP_
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ArgParser.hpp"
+
+namespace ArgumentParser {
+
+/**\n This class parses arguments of an ArgParser incrementally. Tokens are fed
+ * in any number of chunks without the program name and are classified once
+ * as they arrive. An option is resolved as soon as the token of its value has
+ * arrived, a repeated option then takes every following value as it arrives,
+ * so a long run of values is not held back. Only composite options wait for
+ * the end of their run. Every positional value is passed to the callback
+ * right away instead of being stored. If no callback is set, positional
+ * values are collected and passed to the positional arguments of the parser
+ * in Finish. */
+
+class StreamingParser {
+ public:
+  using PositionalCallback = std::function<bool(std::string_view)>;
+
+  explicit StreamingParser(ArgParser& parser,
+                           PositionalCallback positional_callback = {},
+                           ConditionalOutput error_output = {});
+
+  StreamingParser(const StreamingParser& other) = delete;
+  StreamingParser& operator=(const StreamingParser& other) = delete;
+
+  bool Feed(std::string_view token);
+  bool Feed(const std::vector<std::string>& tokens);
+
+  bool Finish();
+
+  [[nodiscard]] size_t GetPendingSize() const;
+
+ private:
+  ArgParser& parser_;
+  PositionalCallback positional_callback_;
+  ConditionalOutput error_output_;
+  std::deque<std::string> pending_;
+  std::deque<Token> pending_tokens_;
+  std::vector<std::string> positional_values_;
+  std::vector<size_t> argument_indices_;
+  std::vector<size_t> continued_indices_;
+  std::vector<size_t> used_positions_;
+  std::vector<Token> tokens_;
+  size_t scanned_tokens_ = 0;
+  bool is_failed_ = false;
+  bool is_stopped_ = false;
+  bool is_finishing_ = false;
+
+  void ProcessPending();
+
+  [[nodiscard]] bool IsOptionReady();
+
+  void ResolveOption();
+
+  void ContinueOption();
+
+  void PopPending(size_t count);
+};
+
+}
+
+#endif //STREAMINGPARSER_HPP_
@@ -0,0 +1,52 @@
+#include "Token.hpp"
+
+ArgumentParser::Token ArgumentParser::ClassifyToken(std::string_view token) {
+  Token result;
+
+  if (!token.empty() && (token.front() == '\'' || token.front() == '"')) {
+    token.remove_prefix(1);
+  }
+
+  if (!token.empty() && (token.back() == '\'' || token.back() == '"')) {
+    token.remove_suffix(1);
+  }
+
+  result.text = token;
+
+  if (token.empty() || token[0] != '-') {
+    return result;
+  }
+
+  if (token == "--") {
+    result.kind = TokenKind::kTerminator;
+    return result;
+  }
+
+  const size_t key_begin = token.size() > 1 && token[1] == '-' ? 2 : 1;
+  const size_t equals_index = token.find('=', key_begin);
+  result.key = token.substr(key_begin, equals_index - key_begin);
+
+  if (equals_index != std::string_view::npos) {
+    result.value = token.substr(equals_index + 1);
+    result.has_value = true;
+  }
+
+  if (key_begin == 2) {
+    result.kind = TokenKind::kLongKey;
+  } else {
+    result.kind = result.key.size() > 1 ? TokenKind::kBundle : TokenKind::kShortKey;
+  }
+
+  return result;
+}
+
+void ArgumentParser::ClassifyTokens(std::span<const std::string> argv, std::vector<Token>& tokens) {
+  tokens.clear();
+  tokens.reserve(argv.size() + 1);
+
+  for (const std::string& token : argv) {
+    tokens.push_back(ClassifyToken(token));
+  }
+
+  tokens.push_back({"--", {}, {}, TokenKind::kTerminator, false});
+}
@@ -0,0 +1,53 @@
+#ifndef TOKEN_HPP_
+#define TOKEN_HPP_
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ArgumentParser {
+
+enum class TokenKind : uint8_t {
+  kValue,
+  kLongKey,
+  kShortKey,
+  kBundle,
+  kTerminator
+};
+
+/**\n This struct describes a token of the command line. The text is the token
+ * without its enclosing quotes, the key is the text between the dashes and
+ * the first '=', the value is the text after it. A token that does not start
+ * with '-' is a value, "--" is the terminator and a single "-" is a short key
+ * with an empty key. All views point into the original token. */
+
+struct Token {
+  std::string_view text;
+  std::string_view key;
+  std::string_view value;
+  TokenKind kind = TokenKind::kValue;
+  bool has_value = false;
+
+  [[nodiscard]] bool IsValue() const {
+    return kind == TokenKind::kValue;
+  }
+
+  [[nodiscard]] bool IsTerminator() const {
+    return kind == TokenKind::kTerminator;
+  }
+};
+
+/**\n This function classifies a token in a single pass over its bytes. */
+
+Token ClassifyToken(std::string_view token);
+
+/**\n This function classifies all tokens and appends the terminator, so
+ * that the stages of parsing never look past the end of the tokens. */
+
+void ClassifyTokens(std::span<const std::string> argv, std::vector<Token>& tokens);
+
+}
+
+#endif //TOKEN_HPP_
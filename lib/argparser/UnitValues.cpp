@@ -0,0 +1,178 @@
+#include <limits>
+#include <span>
+
+#include "UnitValues.hpp"
+
+namespace {
+
+struct Unit {
+  std::string_view suffix;
+  uint64_t multiplier;
+};
+
+constexpr uint64_t kKibi = uint64_t{1} << 10;
+constexpr uint64_t kKilo = 1000;
+
+/* Units used for rendering come first in each table, from the largest one. */
+
+constexpr Unit kSizeUnits[] = {
+    {"EiB", kKibi * kKibi * kKibi * kKibi * kKibi * kKibi}, {"PiB", kKibi * kKibi * kKibi * kKibi * kKibi},
+    {"TiB", kKibi * kKibi * kKibi * kKibi}, {"GiB", kKibi * kKibi * kKibi}, {"MiB", kKibi * kKibi},
+    {"KiB", kKibi},
+    {"EB", kKilo * kKilo * kKilo * kKilo * kKilo * kKilo}, {"PB", kKilo * kKilo * kKilo * kKilo * kKilo},
+    {"TB", kKilo * kKilo * kKilo * kKilo}, {"GB", kKilo * kKilo * kKilo}, {"MB", kKilo * kKilo}, {"kB", kKilo},
+    {"B", 1},
+    {"Ei", kKibi * kKibi * kKibi * kKibi * kKibi * kKibi}, {"Pi", kKibi * kKibi * kKibi * kKibi * kKibi},
+    {"Ti", kKibi * kKibi * kKibi * kKibi}, {"Gi", kKibi * kKibi * kKibi}, {"Mi", kKibi * kKibi}, {"Ki", kKibi},
+    {"E", kKilo * kKilo * kKilo * kKilo * kKilo * kKilo}, {"P", kKilo * kKilo * kKilo * kKilo * kKilo},
+    {"T", kKilo * kKilo * kKilo * kKilo}, {"G", kKilo * kKilo * kKilo}, {"M", kKilo * kKilo},
+    {"KB", kKilo}, {"k", kKilo}, {"K", kKilo}, {"", 1}
+};
+constexpr size_t kSizeRenderedUnits = 13;
+
+constexpr uint64_t kSecond = 1000000000;
+
+constexpr Unit kDurationUnits[] = {
+    {"d", 24 * 60 * 60 * kSecond}, {"h", 60 * 60 * kSecond}, {"min", 60 * kSecond}, {"s", kSecond},
+    {"ms", kSecond / kKilo}, {"us", kSecond / kKilo / kKilo}, {"ns", 1},
+    {"m", 60 * kSecond}
+};
+constexpr size_t kDurationRenderedUnits = 7;
+
+constexpr Unit kRateUnits[] = {
+    {"T", kKilo * kKilo * kKilo * kKilo}, {"G", kKilo * kKilo * kKilo}, {"M", kKilo * kKilo}, {"k", kKilo},
+    {"", 1}
+};
+constexpr size_t kRateRenderedUnits = 5;
+
+/* Parses "<digits>[.<digits>]<suffix>" in one pass over the text, the suffix
+ * is looked up in the table. The fractional part is converted exactly with
+ * Horner's scheme from the last digit: floor((d + floor(r)) / 10) equals
+ * floor((d + r) / 10) for an integer d. */
+
+bool ParseWithUnits(std::string_view text, std::span<const Unit> units, uint64_t maximum, uint64_t& value) {
+  size_t position = 0;
+  uint64_t integer_part = 0;
+
+  while (position < text.size() && text[position] >= '0' && text[position] <= '9') {
+    const auto digit = static_cast<uint64_t>(text[position] - '0');
+
+    if (integer_part > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+      return false;
+    }
+
+    integer_part = integer_part * 10 + digit;
+    ++position;
+  }
+
+  if (position == 0) {
+    return false;
+  }
+
+  std::string_view fraction;
+
+  if (position < text.size() && text[position] == '.') {
+    const size_t fraction_begin = ++position;
+
+    while (position < text.size() && text[position] >= '0' && text[position] <= '9') {
+      ++position;
+    }
+
+    fraction = text.substr(fraction_begin, position - fraction_begin);
+
+    if (fraction.empty()) {
+      return false;
+    }
+  }
+
+  const std::string_view suffix = text.substr(position);
+  const Unit* unit = nullptr;
+
+  for (const Unit& current : units) {
+    if (current.suffix == suffix) {
+      unit = &current;
+      break;
+    }
+  }
+
+  if (unit == nullptr || integer_part > maximum / unit->multiplier) {
+    return false;
+  }
+
+  uint64_t result = integer_part * unit->multiplier;
+
+  if (!fraction.empty()) {
+    if (unit->multiplier > std::numeric_limits<uint64_t>::max() / 10) {
+      return false;
+    }
+
+    uint64_t fraction_part = 0;
+
+    for (size_t i = fraction.size(); i > 0; --i) {
+      fraction_part = (static_cast<uint64_t>(fraction[i - 1] - '0') * unit->multiplier + fraction_part) / 10;
+    }
+
+    if (result > maximum - fraction_part) {
+      return false;
+    }
+
+    result += fraction_part;
+  }
+
+  value = result;
+
+  return true;
+}
+
+std::string FormatWithUnits(uint64_t value, std::span<const Unit> units) {
+  for (const Unit& unit : units) {
+    if (value != 0 && value % unit.multiplier == 0) {
+      return std::to_string(value / unit.multiplier) + std::string(unit.suffix);
+    }
+  }
+
+  return "0" + std::string(units.back().suffix);
+}
+
+}
+
+bool ArgumentParser::ParseSize(std::string_view text, Size& value) {
+  return ParseWithUnits(text, kSizeUnits, std::numeric_limits<uint64_t>::max(), value.bytes);
+}
+
+bool ArgumentParser::ParseDuration(std::string_view text, Duration& value) {
+  uint64_t nanoseconds = 0;
+
+  if (text == "0") {
+    value.value = std::chrono::nanoseconds(0);
+    return true;
+  }
+
+  if (!ParseWithUnits(text, kDurationUnits, std::numeric_limits<std::chrono::nanoseconds::rep>::max(), nanoseconds)) {
+    return false;
+  }
+
+  value.value = std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(nanoseconds));
+
+  return true;
+}
+
+bool ArgumentParser::ParseRate(std::string_view text, Rate& value) {
+  if (text.ends_with("/s")) {
+    text.remove_suffix(2);
+  }
+
+  return ParseWithUnits(text, kRateUnits, std::numeric_limits<uint64_t>::max(), value.per_second);
+}
+
+std::string ArgumentParser::FormatSize(Size value) {
+  return FormatWithUnits(value.bytes, std::span(kSizeUnits, kSizeRenderedUnits));
+}
+
+std::string ArgumentParser::FormatDuration(Duration value) {
+  return FormatWithUnits(static_cast<uint64_t>(value.value.count()), std::span(kDurationUnits, kDurationRenderedUnits));
+}
+
+std::string ArgumentParser::FormatRate(Rate value) {
+  return FormatWithUnits(value.per_second, std::span(kRateUnits, kRateRenderedUnits));
+}
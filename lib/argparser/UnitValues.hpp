@@ -0,0 +1,110 @@
+#ifndef UNITVALUES_HPP_
+#define UNITVALUES_HPP_
+
+#include <chrono>
+#include <compare>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "ArgParserConcepts.hpp"
+#include "ValueFormatter.hpp"
+
+#ifndef ARGPARSER_NO_IOSTREAM
+#include <ostream>
+#endif
+
+namespace ArgumentParser {
+
+/**\n Amount of bytes, written as a number with an optional decimal (kB, MB, ...)
+ * or binary (KiB, MiB, ...) suffix, e.g. 512MiB or 1.5GB. */
+
+struct Size {
+  uint64_t bytes = 0;
+
+  auto operator<=>(const Size& other) const = default;
+};
+
+/**\n Time interval, written as a number with a mandatory suffix: ns, us, ms,
+ * s, m or min, h, d, e.g. 250ms or 1.5h. Zero may be written without a suffix. */
+
+struct Duration {
+  std::chrono::nanoseconds value{0};
+
+  auto operator<=>(const Duration& other) const = default;
+};
+
+/**\n Number of events per second, written as a number with an optional SI
+ * suffix (k, M, G, T) and an optional "/s", e.g. 10k or 2.5M/s. */
+
+struct Rate {
+  uint64_t per_second = 0;
+
+  auto operator<=>(const Rate& other) const = default;
+};
+
+/**\n These functions parse a value in a single pass without locale and
+ * regular expressions. Return false if the text is not a valid value or the
+ * value does not fit into the type. The fractional part is truncated to the
+ * base unit (bytes, nanoseconds, events). */
+
+bool ParseSize(std::string_view text, Size& value);
+bool ParseDuration(std::string_view text, Duration& value);
+bool ParseRate(std::string_view text, Rate& value);
+
+/**\n These functions render a value with the largest unit that represents it
+ * exactly, so that parsing the result gives the same value. */
+
+std::string FormatSize(Size value);
+std::string FormatDuration(Duration value);
+std::string FormatRate(Rate value);
+
+template<>
+struct ValueFormatter<Size> {
+  static std::string Format(const Size& value) {
+    return FormatSize(value);
+  }
+};
+
+template<>
+struct ValueFormatter<Duration> {
+  static std::string Format(const Duration& value) {
+    return FormatDuration(value);
+  }
+};
+
+template<>
+struct ValueFormatter<Rate> {
+  static std::string Format(const Rate& value) {
+    return FormatRate(value);
+  }
+};
+
+template<>
+struct RawSerializable<Size> : std::true_type {};
+
+template<>
+struct RawSerializable<Duration> : std::true_type {};
+
+template<>
+struct RawSerializable<Rate> : std::true_type {};
+
+#ifndef ARGPARSER_NO_IOSTREAM
+
+inline std::ostream& operator<<(std::ostream& os, const Size& value) {
+  return os << FormatSize(value);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const Duration& value) {
+  return os << FormatDuration(value);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const Rate& value) {
+  return os << FormatRate(value);
+}
+
+#endif
+
+}
+
+#endif //UNITVALUES_HPP_
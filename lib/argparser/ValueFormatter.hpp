@@ -0,0 +1,80 @@
+#ifndef VALUEFORMATTER_HPP_
+#define VALUEFORMATTER_HPP_
+
+#include <charconv>
+#include <concepts>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "ArgParserConcepts.hpp"
+
+#ifndef ARGPARSER_NO_IOSTREAM
+#include <sstream>
+#endif
+
+namespace ArgumentParser {
+
+/**\n Customization point for rendering values of user types in the help
+ * (default values). A specialization must provide
+ * static std::string Format(const T& value). */
+
+template<typename T>
+struct ValueFormatter;
+
+template<typename T>
+concept HasValueFormatter = requires(const T& value) {
+  { ValueFormatter<T>::Format(value) } -> std::convertible_to<std::string>;
+};
+
+/**\n This function renders a value as text: through ValueFormatter if it is
+ * specialized, with std::to_chars for integers, as is for strings and through
+ * operator<< otherwise. Floating-point numbers are written by operator<<
+ * and without iostreams by std::to_chars in the same %g form with 6
+ * significant digits. Without iostreams values of other types are empty. */
+
+template<typename T>
+std::string FormatValue(const T& value) {
+  if constexpr (HasValueFormatter<T>) {
+    return ValueFormatter<T>::Format(value);
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return value ? "1" : "0";
+  } else if constexpr (std::is_same_v<T, char>) {
+    return std::string(1, value);
+  }
+#ifndef ARGPARSER_NO_IOSTREAM
+  else if constexpr (std::is_floating_point_v<T>) {
+    std::ostringstream stream;
+    stream << value;
+    return stream.str();
+  }
+#else
+  else if constexpr (std::is_floating_point_v<T>) {
+    char buffer[64];
+    const std::to_chars_result result =
+        std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general, 6);
+    return {buffer, result.ptr};
+  }
+#endif
+  else if constexpr (std::is_arithmetic_v<T>) {
+    char buffer[64];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return {buffer, result.ptr};
+  } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+    return std::string(std::string_view(value));
+  }
+#ifndef ARGPARSER_NO_IOSTREAM
+  else if constexpr (Writeable<T>) {
+    std::ostringstream stream;
+    stream << value;
+    return stream.str();
+  }
+#endif
+  else {
+    return {};
+  }
+}
+
+}
+
+#endif //VALUEFORMATTER_HPP_
@@ -0,0 +1,49 @@
+#ifndef VALUESINK_HPP_
+#define VALUESINK_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "ArgParserConcepts.hpp"
+
+namespace ArgumentParser {
+
+/**\n This class passes the values of an argument to a container of the user
+ * given to StoreValues. Values are parsed into the vector of the argument as
+ * usual and the new ones are copied to the container after each occurrence
+ * of the argument, so GetValues and GetValueReference keep working. */
+
+template<typename T>
+class ValueSink {
+ public:
+  virtual ~ValueSink() = default;
+  virtual void Clear() = 0;
+  virtual void Append(const std::vector<T>& values, size_t begin) = 0;
+};
+
+template<typename T, ValueContainer<T> Container>
+class ContainerValueSink final : public ValueSink<T> {
+ public:
+  explicit ContainerValueSink(Container& container) : container_(container) {}
+
+  void Clear() override {
+    container_.clear();
+  }
+
+  void Append(const std::vector<T>& values, size_t begin) override {
+    for (size_t i = begin; i < values.size(); ++i) {
+      if constexpr (requires(Container container, const T& value) { container.push_back(value); }) {
+        container_.push_back(values[i]);
+      } else {
+        container_.insert(values[i]);
+      }
+    }
+  }
+
+ private:
+  Container& container_;
+};
+
+}
+
+#endif //VALUESINK_HPP_
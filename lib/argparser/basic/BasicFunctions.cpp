@@ -1,12 +1,29 @@
-#include <iostream>
 #include <filesystem>
 #include "BasicFunctions.hpp"
+#include "ByteScan.hpp"
+#include "PathCache.hpp"
+
+#ifndef ARGPARSER_NO_IOSTREAM
+#include <iostream>
+#endif
+
+namespace {
+
+void WriteToConsole(std::string_view text) {
+#ifdef ARGPARSER_NO_IOSTREAM
+  ArgumentParser::OutputSink().Write(text);
+#else
+  std::cout << text;
+#endif
+}
+
+}
 
 void ArgumentParser::SetRedColor() {
   /* Changes the color of the console output to red if not running
    * on Windows. */
 
-  std::cout << (IsWindows() ? "" : "\x1B[31m");
+  WriteToConsole(IsWindows() ? "" : "\x1B[31m");
 
   /* Conditional block to set the console text color to red if the program is
    * running on Windows, using the Windows API functions. */
@@ -23,7 +40,7 @@ void ArgumentParser::ResetColor() {
     SetConsoleTextAttribute(hConsole, 15);
   }
 
-  std::cout << (IsWindows() ? "" : "\x1B[0m");
+  WriteToConsole(IsWindows() ? "" : "\x1B[0m");
 }
 
 void ArgumentParser::DisplayError(const std::string& message, ConditionalOutput error_output) {
@@ -31,13 +48,17 @@ void ArgumentParser::DisplayError(const std::string& message, ConditionalOutput
     return;
   }
 
+#ifdef ARGPARSER_NO_IOSTREAM
+  bool is_console_output = error_output.out_sink.IsConsole();
+#else
   bool is_console_output = &error_output.out_stream == &std::cout || &error_output.out_stream == &std::cerr;
+#endif
 
   if (is_console_output) {
     SetRedColor();
   }
 
-  error_output.out_stream << message;
+  error_output << message;
 
   if (is_console_output) {
     ResetColor();
@@ -54,45 +75,59 @@ bool ArgumentParser::IsWindows() {
       ;
 }
 
-bool ArgumentParser::IsValidFilename(std::string& pre_filename) {
-  if (pre_filename.size() > 7) {
-    if (pre_filename.substr(0, 7) == "file://") {
-      pre_filename = pre_filename.substr(7);
-    }
-  }
+namespace {
 
-  if (IsWindows() && pre_filename.size() > 2) {
-    for (uint64_t position = 2; position < pre_filename.size(); ++position) {
-      char current = pre_filename[position];
-      if (!(std::isalnum(current) || current == '\\' || current == '.' ||
-          current == '-' || current == ' ' || current == '_')) {
-        return false;
-      }
-    }
-  }
+constexpr std::string_view kFileScheme = "file://";
 
+std::string_view SkipFileScheme(std::string_view path) {
+  return (path.size() > kFileScheme.size() && path.starts_with(kFileScheme)) ? path.substr(kFileScheme.size()) : path;
+}
+
+bool IsValidPathWithoutScheme(std::string_view path) {
   /* This Windows-specific check is important because different code pages can
    * corrupt non-alphanumeric filenames, but UNIX-like systems (like macOS or
    * Linux) handle Unicode correctly. */
 
-  for (uint64_t position = 0; position < pre_filename.size() - 1; ++position) {
-    const char current = pre_filename[position];
-    const char next = pre_filename[position + 1];
+  if (ArgumentParser::IsWindows() && path.size() > 2 &&
+      ArgumentParser::FindNonWindowsPathSymbol(path.substr(2)) != std::string_view::npos) {
+    return false;
+  }
+
+  return ArgumentParser::FindRepeatedSeparator(path) == std::string_view::npos;
+}
+
+}
 
-    if ((current == '\\' || current == '/') && next == current) {
-      return false;
-    }
+bool ArgumentParser::IsValidFilename(std::string& pre_filename) {
+  if (SkipFileScheme(pre_filename).size() != pre_filename.size()) {
+    pre_filename.erase(0, kFileScheme.size());
   }
 
-  return true;
+  return IsValidPathWithoutScheme(pre_filename);
+}
+
+bool ArgumentParser::IsValidPath(std::string_view path) {
+  return IsValidPathWithoutScheme(SkipFileScheme(path));
 }
 
 bool ArgumentParser::IsRegularFile(std::string& filename) {
+  PathCache* cache = PathCache::GetActive();
+
+  if (cache != nullptr) {
+    return cache->GetKind(filename) == PathKind::kRegularFile;
+  }
+
   std::filesystem::path path(filename);
   return std::filesystem::is_regular_file(path);
 }
 
 bool ArgumentParser::IsDirectory(std::string& dirname) {
+  PathCache* cache = PathCache::GetActive();
+
+  if (cache != nullptr) {
+    return cache->GetKind(dirname) == PathKind::kDirectory;
+  }
+
   std::filesystem::path path(dirname);
   return std::filesystem::is_directory(path);
 }
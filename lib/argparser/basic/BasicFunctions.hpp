@@ -2,8 +2,8 @@
 #define ARGPARSER_BASICFUNCTIONS_HPP_
 
 #include <cstdint>
+#include <string>
 #include <string_view>
-#include <iostream>
 
 #include "ConditionalOutput.hpp"
 
@@ -40,15 +40,23 @@ bool IsWindows();
 /**\n The code validates the validity of a filename based on rules specific to
  * Windows. The filename should consist of alphanumeric characters, backslashes,
  * periods, hyphens, and spaces. Additionally, the code checks for consecutive
- * slashes in the filename, which is also considered invalid. */
+ * slashes in the filename, which is also considered invalid. A "file://"
+ * prefix is removed from the filename in place. */
 
 bool IsValidFilename(std::string& pre_filename);
 
-/**\n This function is a wrapper for the std::filesystem::is_regular_file function. */
+/**\n This function applies the same rules as IsValidFilename to a path that
+ * is not modified: the "file://" prefix is skipped without copying. */
+
+bool IsValidPath(std::string_view path);
+
+/**\n This function is a wrapper for the std::filesystem::is_regular_file function.
+ * If a PathCache is active on the current thread, the result is taken from it. */
 
 bool IsRegularFile(std::string& filename);
 
-/**\n This function is a wrapper for the std::filesystem::is_directory function. */
+/**\n This function is a wrapper for the std::filesystem::is_directory function.
+ * If a PathCache is active on the current thread, the result is taken from it. */
 
 bool IsDirectory(std::string& dirname);
 
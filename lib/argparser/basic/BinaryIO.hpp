@@ -0,0 +1,39 @@
+#ifndef ARGPARSER_BINARYIO_HPP_
+#define ARGPARSER_BINARYIO_HPP_
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace ArgumentParser {
+
+/**\n This function appends the object representation of a trivially copyable
+ * value to the output buffer. */
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+void WriteBinary(std::string& output, const T& value) {
+  output.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**\n This function reads a trivially copyable value from the beginning of the
+ * input buffer and advances the buffer. Returns false if the buffer is too
+ * short. The buffer may be unaligned. */
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+bool ReadBinary(std::string_view& input, T& value) {
+  if (input.size() < sizeof(T)) {
+    return false;
+  }
+
+  std::memcpy(&value, input.data(), sizeof(T));
+  input.remove_prefix(sizeof(T));
+
+  return true;
+}
+
+}
+
+#endif //ARGPARSER_BINARYIO_HPP_
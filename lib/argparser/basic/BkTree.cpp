@@ -0,0 +1,104 @@
+#include <algorithm>
+
+#include "BkTree.hpp"
+
+void ArgumentParser::BkTree::Insert(std::string_view word) {
+  if (nodes_.empty()) {
+    nodes_.push_back({word, 0, kNoNode, kNoNode});
+    return;
+  }
+
+  uint32_t node = 0;
+
+  while (true) {
+    const size_t distance = GetDistance(word, nodes_[node].word, row_);
+
+    if (distance == 0) {
+      return;
+    }
+
+    uint32_t* link = &nodes_[node].first_child;
+
+    while (*link != kNoNode && nodes_[*link].distance != distance) {
+      link = &nodes_[*link].next_sibling;
+    }
+
+    if (*link == kNoNode) {
+      *link = static_cast<uint32_t>(nodes_.size());
+      nodes_.push_back({word, distance, kNoNode, kNoNode});
+      return;
+    }
+
+    node = *link;
+  }
+}
+
+void ArgumentParser::BkTree::Reserve(size_t size) {
+  nodes_.reserve(size);
+}
+
+void ArgumentParser::BkTree::Clear() {
+  nodes_.clear();
+}
+
+std::string_view ArgumentParser::BkTree::FindClosest(std::string_view word, size_t maximum_distance) const {
+  if (nodes_.empty()) {
+    return {};
+  }
+
+  std::vector<size_t> row;
+  std::vector<uint32_t> stack = {0};
+  uint32_t best_node = kNoNode;
+  size_t best_distance = maximum_distance + 1;
+
+  /* The search radius shrinks to the best distance found so far, so the
+   * rest of the tree is pruned harder as closer words are met. */
+
+  while (!stack.empty()) {
+    const uint32_t node = stack.back();
+    stack.pop_back();
+    const size_t distance = GetDistance(word, nodes_[node].word, row);
+
+    if (distance < best_distance || (distance == best_distance && node < best_node)) {
+      best_distance = distance;
+      best_node = node;
+    }
+
+    const size_t radius = std::min(best_distance, maximum_distance);
+
+    for (uint32_t child = nodes_[node].first_child; child != kNoNode; child = nodes_[child].next_sibling) {
+      if (nodes_[child].distance + radius >= distance && nodes_[child].distance <= distance + radius) {
+        stack.push_back(child);
+      }
+    }
+  }
+
+  return best_node == kNoNode ? std::string_view() : nodes_[best_node].word;
+}
+
+size_t ArgumentParser::BkTree::GetSize() const {
+  return nodes_.size();
+}
+
+size_t ArgumentParser::BkTree::GetDistance(std::string_view first,
+                                           std::string_view second,
+                                           std::vector<size_t>& row) {
+  row.resize(second.size() + 1);
+
+  for (size_t j = 0; j <= second.size(); ++j) {
+    row[j] = j;
+  }
+
+  for (size_t i = 1; i <= first.size(); ++i) {
+    size_t diagonal = row[0];
+    row[0] = i;
+
+    for (size_t j = 1; j <= second.size(); ++j) {
+      const size_t above = row[j];
+      row[j] = std::min({row[j] + 1, row[j - 1] + 1, diagonal + (first[i - 1] == second[j - 1] ? 0 : 1)});
+      diagonal = above;
+    }
+  }
+
+  return row[second.size()];
+}
@@ -0,0 +1,52 @@
+#ifndef ARGPARSER_BKTREE_HPP_
+#define ARGPARSER_BKTREE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace ArgumentParser {
+
+/**\n This class is a BK-tree of words under the Levenshtein distance. Every
+ * child is stored at its distance from the parent, so by the triangle
+ * inequality a query visits only the children whose distance differs from
+ * the distance to the parent by no more than the searched one. The words are
+ * not copied and must outlive the tree. */
+
+class BkTree {
+ public:
+  void Insert(std::string_view word);
+  void Reserve(size_t size);
+  void Clear();
+
+  /**\n This method returns the word closest to the given one within the
+   * maximum distance, or an empty view. Of equally close words the one
+   * inserted first is returned. */
+
+  [[nodiscard]] std::string_view FindClosest(std::string_view word, size_t maximum_distance) const;
+
+  [[nodiscard]] size_t GetSize() const;
+
+  /**\n This function computes the Levenshtein distance between the words,
+   * the row is a buffer reused between calls. */
+
+  static size_t GetDistance(std::string_view first, std::string_view second, std::vector<size_t>& row);
+
+ private:
+  static constexpr uint32_t kNoNode = UINT32_MAX;
+
+  struct Node {
+    std::string_view word;
+    size_t distance;
+    uint32_t first_child;
+    uint32_t next_sibling;
+  };
+
+  std::vector<Node> nodes_;
+  std::vector<size_t> row_;
+};
+
+}
+
+#endif //ARGPARSER_BKTREE_HPP_
@@ -0,0 +1,148 @@
+#ifndef ARGPARSER_BYTESCAN_HPP_
+#define ARGPARSER_BYTESCAN_HPP_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined __AVX2__
+#include <immintrin.h>
+#define ARGPARSER_BYTESCAN_AVX2
+#elif defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ARGPARSER_BYTESCAN_SSE2
+#endif
+
+namespace ArgumentParser {
+
+/**\n These functions scan a text for bytes that make a path invalid. They
+ * compare 32 bytes at once with AVX2 or 16 bytes with SSE2, whichever the
+ * compiler targets, and finish the remaining bytes one by one; without these
+ * instruction sets the whole text is scanned one byte at a time. Both return
+ * the position of the first match or std::string_view::npos. */
+
+inline bool IsPathSeparator(char symbol) {
+  return symbol == '/' || symbol == '\\';
+}
+
+/**\n This function checks if the symbol may appear in a Windows path after the
+ * drive: ASCII letters and digits, '\\', '.', '-', ' ' and '_'. */
+
+inline bool IsWindowsPathSymbol(char symbol) {
+  return (symbol >= 'a' && symbol <= 'z') || (symbol >= 'A' && symbol <= 'Z') || (symbol >= '0' && symbol <= '9') ||
+      symbol == '\\' || symbol == '.' || symbol == '-' || symbol == ' ' || symbol == '_';
+}
+
+/**\n This function finds the first separator ('/' or '\\') that is followed
+ * by the same separator. */
+
+inline size_t FindRepeatedSeparator(std::string_view text) {
+  size_t position = 0;
+
+#if defined ARGPARSER_BYTESCAN_AVX2
+  const __m256i slash = _mm256_set1_epi8('/');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+
+  for (; position + 32 < text.size(); position += 32) {
+    const __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + position));
+    const __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + position + 1));
+    const __m256i is_separator = _mm256_or_si256(_mm256_cmpeq_epi8(current, slash),
+                                                 _mm256_cmpeq_epi8(current, backslash));
+    const auto mask = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_and_si256(is_separator, _mm256_cmpeq_epi8(current, next))));
+
+    if (mask != 0) {
+      return position + static_cast<size_t>(std::countr_zero(mask));
+    }
+  }
+#elif defined ARGPARSER_BYTESCAN_SSE2
+  const __m128i slash = _mm_set1_epi8('/');
+  const __m128i backslash = _mm_set1_epi8('\\');
+
+  for (; position + 16 < text.size(); position += 16) {
+    const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + position));
+    const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + position + 1));
+    const __m128i is_separator = _mm_or_si128(_mm_cmpeq_epi8(current, slash), _mm_cmpeq_epi8(current, backslash));
+    const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(is_separator, _mm_cmpeq_epi8(current, next))));
+
+    if (mask != 0) {
+      return position + static_cast<size_t>(std::countr_zero(mask));
+    }
+  }
+#endif
+
+  for (; position + 1 < text.size(); ++position) {
+    if (IsPathSeparator(text[position]) && text[position + 1] == text[position]) {
+      return position;
+    }
+  }
+
+  return std::string_view::npos;
+}
+
+/**\n This function finds the first symbol rejected by IsWindowsPathSymbol.
+ * Bytes outside ASCII are negative as signed chars, so the signed range
+ * comparisons reject them as well. */
+
+inline size_t FindNonWindowsPathSymbol(std::string_view text) {
+  size_t position = 0;
+
+#if defined ARGPARSER_BYTESCAN_AVX2
+  const auto in_range = [](__m256i bytes, char first, char last) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(static_cast<char>(first - 1))),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(last + 1)), bytes));
+  };
+  const auto equals = [](__m256i bytes, char symbol) {
+    return _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(symbol));
+  };
+
+  for (; position + 32 <= text.size(); position += 32) {
+    const __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + position));
+    const __m256i letters = in_range(_mm256_or_si256(current, _mm256_set1_epi8(0x20)), 'a', 'z');
+    const __m256i others = _mm256_or_si256(_mm256_or_si256(equals(current, '\\'), equals(current, '.')),
+                                           _mm256_or_si256(_mm256_or_si256(equals(current, '-'), equals(current, ' ')),
+                                                           equals(current, '_')));
+    const __m256i allowed = _mm256_or_si256(_mm256_or_si256(letters, in_range(current, '0', '9')), others);
+    const auto mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(allowed));
+
+    if (mask != 0) {
+      return position + static_cast<size_t>(std::countr_zero(mask));
+    }
+  }
+#elif defined ARGPARSER_BYTESCAN_SSE2
+  const auto in_range = [](__m128i bytes, char first, char last) {
+    return _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(static_cast<char>(first - 1))),
+                         _mm_cmplt_epi8(bytes, _mm_set1_epi8(static_cast<char>(last + 1))));
+  };
+  const auto equals = [](__m128i bytes, char symbol) {
+    return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(symbol));
+  };
+
+  for (; position + 16 <= text.size(); position += 16) {
+    const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + position));
+    const __m128i letters = in_range(_mm_or_si128(current, _mm_set1_epi8(0x20)), 'a', 'z');
+    const __m128i others = _mm_or_si128(_mm_or_si128(equals(current, '\\'), equals(current, '.')),
+                                        _mm_or_si128(_mm_or_si128(equals(current, '-'), equals(current, ' ')),
+                                                     equals(current, '_')));
+    const __m128i allowed = _mm_or_si128(_mm_or_si128(letters, in_range(current, '0', '9')), others);
+    const auto mask = ~static_cast<uint32_t>(_mm_movemask_epi8(allowed)) & 0xFFFFU;
+
+    if (mask != 0) {
+      return position + static_cast<size_t>(std::countr_zero(mask));
+    }
+  }
+#endif
+
+  for (; position < text.size(); ++position) {
+    if (!IsWindowsPathSymbol(text[position])) {
+      return position;
+    }
+  }
+
+  return std::string_view::npos;
+}
+
+}
+
+#endif //ARGPARSER_BYTESCAN_HPP_
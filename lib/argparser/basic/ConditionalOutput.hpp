@@ -1,12 +1,36 @@
 #ifndef CONDITIONALOUTPUT_HPP_
 #define CONDITIONALOUTPUT_HPP_
 
+#ifdef ARGPARSER_NO_IOSTREAM
+#include <string_view>
+
+#include "OutputSink.hpp"
+#else
 #include <iostream>
+#endif
 
-/**\n Structure for error output in ArgumentParser */
+/**\n Structure for error output in ArgumentParser. If ARGPARSER_NO_IOSTREAM is
+ * defined, the messages are written to an OutputSink instead of a stream. */
 
 namespace ArgumentParser {
 
+#ifdef ARGPARSER_NO_IOSTREAM
+
+struct ConditionalOutput {
+  OutputSink out_sink = {};
+  bool print_messages = false;
+
+  ConditionalOutput& operator<<(std::string_view text) {
+    if (print_messages) {
+      out_sink.Write(text);
+    }
+
+    return *this;
+  }
+};
+
+#else
+
 struct ConditionalOutput {
   std::ostream& out_stream = std::cout;
   bool print_messages = false;
@@ -24,6 +48,8 @@ struct ConditionalOutput {
   }
 };
 
+#endif
+
 }
 
 #endif //CONDITIONALOUTPUT_HPP_
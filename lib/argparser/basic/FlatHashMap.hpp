@@ -0,0 +1,172 @@
+#ifndef ARGPARSER_FLATHASHMAP_HPP_
+#define ARGPARSER_FLATHASHMAP_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ArgumentParser {
+
+/**\n This class is a hash map from strings to values with open addressing.
+ * Entries are stored densely in insertion order, the table of slots holds
+ * the upper half of the hash and the entry number, and is probed linearly.
+ * Lookup takes a std::string_view, so no key is built to find an entry.
+ * Entries are never removed one by one, only cleared all together. */
+
+template<typename V>
+class FlatHashMap {
+ public:
+  struct Entry {
+    std::string key;
+    V value;
+  };
+
+  [[nodiscard]] const V* Find(std::string_view key) const {
+    if (entries_.empty()) {
+      return nullptr;
+    }
+
+    const size_t slot = FindSlot(key, Hash(key));
+    return slots_[slot] == kEmptySlot ? nullptr : &entries_[GetEntryIndex(slots_[slot])].value;
+  }
+
+  [[nodiscard]] V* Find(std::string_view key) {
+    return const_cast<V*>(std::as_const(*this).Find(key));
+  }
+
+  [[nodiscard]] bool Contains(std::string_view key) const {
+    return Find(key) != nullptr;
+  }
+
+  /**\n This method returns the value of the key and true if it was inserted
+   * with a default-constructed value, or the existing value and false. */
+
+  std::pair<V&, bool> TryEmplace(std::string_view key) {
+    if ((entries_.size() + 1) * kMaxLoadDenominator > slots_.size() * kMaxLoadNumerator) {
+      Rehash(std::max<size_t>(slots_.size() * 2, kMinimumSlots));
+    }
+
+    const uint64_t hash = Hash(key);
+    const size_t slot = FindSlot(key, hash);
+
+    if (slots_[slot] != kEmptySlot) {
+      return {entries_[GetEntryIndex(slots_[slot])].value, false};
+    }
+
+    slots_[slot] = (hash & kHashMask) | (entries_.size() + 1);
+    entries_.push_back({std::string(key), V()});
+
+    return {entries_.back().value, true};
+  }
+
+  void Reserve(size_t size) {
+    entries_.reserve(size);
+
+    if (size * kMaxLoadDenominator > slots_.size() * kMaxLoadNumerator) {
+      size_t slots = kMinimumSlots;
+
+      while (size * kMaxLoadDenominator > slots * kMaxLoadNumerator) {
+        slots *= 2;
+      }
+
+      Rehash(slots);
+    }
+  }
+
+  /**\n This method removes all entries and keeps the allocated memory. */
+
+  void Clear() {
+    entries_.clear();
+    std::fill(slots_.begin(), slots_.end(), kEmptySlot);
+  }
+
+  [[nodiscard]] size_t GetSize() const {
+    return entries_.size();
+  }
+
+  [[nodiscard]] bool IsEmpty() const {
+    return entries_.empty();
+  }
+
+  [[nodiscard]] const std::vector<Entry>& GetEntries() const {
+    return entries_;
+  }
+
+  [[nodiscard]] typename std::vector<Entry>::const_iterator begin() const {
+    return entries_.begin();
+  }
+
+  [[nodiscard]] typename std::vector<Entry>::const_iterator end() const {
+    return entries_.end();
+  }
+
+  [[nodiscard]] size_t GetMemoryUsage() const {
+    size_t usage = entries_.capacity() * sizeof(Entry) + slots_.capacity() * sizeof(uint64_t);
+
+    for (const Entry& entry : entries_) {
+      usage += entry.key.capacity() > std::string().capacity() ? entry.key.capacity() + 1 : 0;
+    }
+
+    return usage;
+  }
+
+ private:
+  static constexpr uint64_t kEmptySlot = 0;
+  static constexpr uint64_t kHashMask = 0xFFFFFFFF00000000ULL;
+  static constexpr size_t kMinimumSlots = 16;
+  static constexpr size_t kMaxLoadNumerator = 3;
+  static constexpr size_t kMaxLoadDenominator = 4;
+
+  std::vector<Entry> entries_;
+  std::vector<uint64_t> slots_;
+
+  static uint64_t Hash(std::string_view key) {
+    return std::hash<std::string_view>{}(key) * 0x9E3779B97F4A7C15ULL;
+  }
+
+  static size_t GetEntryIndex(uint64_t slot) {
+    return static_cast<size_t>((slot & ~kHashMask) - 1);
+  }
+
+  /**\n This method returns the slot of the key or the empty slot where it
+   * would be inserted. The slots are compared by the stored hash first. */
+
+  [[nodiscard]] size_t FindSlot(std::string_view key, uint64_t hash) const {
+    const size_t mask = slots_.size() - 1;
+
+    for (size_t slot = static_cast<size_t>(hash >> 32) & mask;; slot = (slot + 1) & mask) {
+      if (slots_[slot] == kEmptySlot) {
+        return slot;
+      }
+
+      if ((slots_[slot] & kHashMask) == (hash & kHashMask) && entries_[GetEntryIndex(slots_[slot])].key == key) {
+        return slot;
+      }
+    }
+  }
+
+  void Rehash(size_t slots) {
+    slots_.assign(slots, kEmptySlot);
+    const size_t mask = slots - 1;
+
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      const uint64_t hash = Hash(entries_[i].key);
+      size_t slot = static_cast<size_t>(hash >> 32) & mask;
+
+      while (slots_[slot] != kEmptySlot) {
+        slot = (slot + 1) & mask;
+      }
+
+      slots_[slot] = (hash & kHashMask) | (i + 1);
+    }
+  }
+};
+
+}
+
+#endif //ARGPARSER_FLATHASHMAP_HPP_
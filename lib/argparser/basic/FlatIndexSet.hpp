@@ -0,0 +1,99 @@
+#ifndef ARGPARSER_FLATINDEXSET_HPP_
+#define ARGPARSER_FLATINDEXSET_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ArgumentParser {
+
+/**\n This class is a hash set of indices into a sequence that it does not own,
+ * with open addressing and linear probing. The hash of an element and the
+ * comparison with the elements already in the set are passed to Insert, so a
+ * slot holds only the upper half of the mixed hash and the index (below 2^32). */
+
+class FlatIndexSet {
+ public:
+  /**\n This method adds the index if no element in the set is equal to it by
+   * is_equal(index_in_set), returns false otherwise. */
+
+  template<typename Equal>
+  bool Insert(uint64_t hash, size_t index, Equal&& is_equal) {
+    hash *= 0x9E3779B97F4A7C15ULL;
+
+    if ((size_ + 1) * kMaxLoadDenominator > slots_.size() * kMaxLoadNumerator) {
+      Rehash(std::max<size_t>(slots_.size() * 2, kMinimumSlots));
+    }
+
+    const size_t mask = slots_.size() - 1;
+
+    for (size_t slot = static_cast<size_t>(hash >> 32) & mask;; slot = (slot + 1) & mask) {
+      if (slots_[slot] == kEmptySlot) {
+        slots_[slot] = (hash & kHashMask) | (index + 1);
+        ++size_;
+        return true;
+      }
+
+      if ((slots_[slot] & kHashMask) == (hash & kHashMask) && is_equal(GetIndex(slots_[slot]))) {
+        return false;
+      }
+    }
+  }
+
+  /**\n This method removes all indices and keeps the allocated memory. */
+
+  void Clear() {
+    std::fill(slots_.begin(), slots_.end(), kEmptySlot);
+    size_ = 0;
+  }
+
+  [[nodiscard]] size_t GetSize() const {
+    return size_;
+  }
+
+  [[nodiscard]] size_t GetMemoryUsage() const {
+    return slots_.capacity() * sizeof(uint64_t);
+  }
+
+ private:
+  static constexpr uint64_t kEmptySlot = 0;
+  static constexpr uint64_t kHashMask = 0xFFFFFFFF00000000ULL;
+  static constexpr size_t kMinimumSlots = 16;
+  static constexpr size_t kMaxLoadNumerator = 3;
+  static constexpr size_t kMaxLoadDenominator = 4;
+
+  std::vector<uint64_t> slots_;
+  size_t size_ = 0;
+
+  static size_t GetIndex(uint64_t slot) {
+    return static_cast<size_t>((slot & ~kHashMask) - 1);
+  }
+
+  /**\n The slot of an index is taken from the stored half of its hash, so
+   * the elements are not hashed again. */
+
+  void Rehash(size_t slots) {
+    std::vector<uint64_t> old_slots(slots, kEmptySlot);
+    old_slots.swap(slots_);
+    const size_t mask = slots - 1;
+
+    for (const uint64_t old_slot : old_slots) {
+      if (old_slot == kEmptySlot) {
+        continue;
+      }
+
+      size_t slot = static_cast<size_t>(old_slot >> 32) & mask;
+
+      while (slots_[slot] != kEmptySlot) {
+        slot = (slot + 1) & mask;
+      }
+
+      slots_[slot] = old_slot;
+    }
+  }
+};
+
+}
+
+#endif //ARGPARSER_FLATINDEXSET_HPP_
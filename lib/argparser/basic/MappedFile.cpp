@@ -0,0 +1,167 @@
+#include <utility>
+
+#include "MappedFile.hpp"
+
+#if defined _WIN32 || defined _WIN64 || defined __CYGWIN__
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ArgumentParser::MappedFile::MappedFile(const std::string& path) {
+  Open(path);
+}
+
+ArgumentParser::MappedFile::MappedFile(MappedFile&& other) noexcept {
+  *this = std::move(other);
+}
+
+ArgumentParser::MappedFile& ArgumentParser::MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    Close();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    is_open_ = std::exchange(other.is_open_, false);
+    file_handle_ = std::exchange(other.file_handle_, nullptr);
+    mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+  }
+
+  return *this;
+}
+
+ArgumentParser::MappedFile::~MappedFile() {
+  Close();
+}
+
+bool ArgumentParser::MappedFile::IsOpen() const {
+  return is_open_;
+}
+
+const char* ArgumentParser::MappedFile::GetData() const {
+  return data_;
+}
+
+size_t ArgumentParser::MappedFile::GetSize() const {
+  return size_;
+}
+
+#if defined _WIN32 || defined _WIN64 || defined __CYGWIN__
+
+bool ArgumentParser::MappedFile::Open(const std::string& path) {
+  Close();
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+
+  LARGE_INTEGER file_size;
+
+  if (!GetFileSizeEx(file, &file_size)) {
+    CloseHandle(file);
+    return false;
+  }
+
+  file_handle_ = file;
+  is_open_ = true;
+
+  if (file_size.QuadPart == 0) {
+    return true;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  if (mapping == nullptr) {
+    Close();
+    return false;
+  }
+
+  mapping_handle_ = mapping;
+  data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+  if (data_ == nullptr) {
+    Close();
+    return false;
+  }
+
+  size_ = static_cast<size_t>(file_size.QuadPart);
+
+  return true;
+}
+
+void ArgumentParser::MappedFile::Close() {
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+
+  if (mapping_handle_ != nullptr) {
+    CloseHandle(static_cast<HANDLE>(mapping_handle_));
+  }
+
+  if (file_handle_ != nullptr) {
+    CloseHandle(static_cast<HANDLE>(file_handle_));
+  }
+
+  data_ = nullptr;
+  size_ = 0;
+  is_open_ = false;
+  file_handle_ = nullptr;
+  mapping_handle_ = nullptr;
+}
+
+#else
+
+bool ArgumentParser::MappedFile::Open(const std::string& path) {
+  Close();
+  const int descriptor = open(path.c_str(), O_RDONLY);
+
+  if (descriptor < 0) {
+    return false;
+  }
+
+  struct stat file_status{};
+
+  if (fstat(descriptor, &file_status) != 0 || !S_ISREG(file_status.st_mode)) {
+    close(descriptor);
+    return false;
+  }
+
+  is_open_ = true;
+
+  if (file_status.st_size > 0) {
+    void* data = mmap(nullptr, static_cast<size_t>(file_status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+    if (data == MAP_FAILED) {
+      is_open_ = false;
+    } else {
+      data_ = static_cast<const char*>(data);
+      size_ = static_cast<size_t>(file_status.st_size);
+    }
+  }
+
+  /* The mapping stays valid after the descriptor is closed, so there is no
+   * need to keep it open. */
+
+  close(descriptor);
+
+  return is_open_;
+}
+
+void ArgumentParser::MappedFile::Close() {
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+
+  data_ = nullptr;
+  size_ = 0;
+  is_open_ = false;
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef ARGPARSER_MAPPEDFILE_HPP_
+#define ARGPARSER_MAPPEDFILE_HPP_
+
+#include <cstddef>
+#include <string>
+
+namespace ArgumentParser {
+
+/**\n This class maps a whole file into memory for reading. The mapping is
+ * released in the destructor. An empty file is considered to be opened, but
+ * has no data. */
+
+class MappedFile {
+ public:
+  MappedFile() = default;
+  explicit MappedFile(const std::string& path);
+  MappedFile(const MappedFile& other) = delete;
+  MappedFile& operator=(const MappedFile& other) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  ~MappedFile();
+
+  bool Open(const std::string& path);
+  void Close();
+
+  [[nodiscard]] bool IsOpen() const;
+  [[nodiscard]] const char* GetData() const;
+  [[nodiscard]] size_t GetSize() const;
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  bool is_open_ = false;
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+};
+
+}
+
+#endif //ARGPARSER_MAPPEDFILE_HPP_
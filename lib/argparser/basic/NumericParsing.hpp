@@ -0,0 +1,134 @@
+#ifndef ARGPARSER_NUMERICPARSING_HPP_
+#define ARGPARSER_NUMERICPARSING_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace ArgumentParser {
+
+/**\n This function checks if all eight bytes of the chunk are decimal digits. */
+
+inline bool IsEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+      (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+/**\n This function converts eight decimal digits loaded in little-endian order
+ * into their value using three multiply-and-shift steps (SWAR). */
+
+inline uint32_t ParseEightDigits(uint64_t chunk) {
+  chunk -= 0x3030303030303030ULL;
+  chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFULL;
+  chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFFULL;
+  chunk = (chunk * 10000 + (chunk >> 32)) & 0x00000000FFFFFFFFULL;
+  return static_cast<uint32_t>(chunk);
+}
+
+/**\n This function parses a decimal integer without leading zeros from the
+ * beginning of the text and advances the text. Returns false if the text
+ * does not start with such an integer or the value does not fit into T. */
+
+template<std::integral T>
+bool ParseDecimalInteger(std::string_view& text, T& value) {
+  bool is_negative = false;
+  size_t position = 0;
+
+  if (position < text.size() && (text[position] == '-' || text[position] == '+')) {
+    is_negative = text[position] == '-';
+    ++position;
+  }
+
+  if (position >= text.size() || text[position] < '0' || text[position] > '9' ||
+      (text[position] == '0' && position + 1 < text.size() && text[position + 1] >= '0' && text[position + 1] <= '9')) {
+    return false;
+  }
+
+  uint64_t magnitude = 0;
+
+  if constexpr (std::endian::native == std::endian::little) {
+    uint64_t chunk;
+
+    while (position + sizeof(chunk) <= text.size() &&
+        (std::memcpy(&chunk, text.data() + position, sizeof(chunk)), IsEightDigits(chunk))) {
+      if (magnitude > (std::numeric_limits<uint64_t>::max() - 99999999ULL) / 100000000ULL) {
+        return false;
+      }
+
+      magnitude = magnitude * 100000000ULL + ParseEightDigits(chunk);
+      position += sizeof(chunk);
+    }
+  }
+
+  while (position < text.size() && text[position] >= '0' && text[position] <= '9') {
+    const auto digit = static_cast<uint64_t>(text[position] - '0');
+
+    if (magnitude > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+      return false;
+    }
+
+    magnitude = magnitude * 10 + digit;
+    ++position;
+  }
+
+  if constexpr (std::is_signed_v<T>) {
+    const auto limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (is_negative ? 1 : 0);
+
+    if (magnitude > limit) {
+      return false;
+    }
+
+    value = is_negative ? static_cast<T>(0 - magnitude) : static_cast<T>(magnitude);
+  } else {
+    if ((is_negative && magnitude != 0) || magnitude > std::numeric_limits<T>::max()) {
+      return false;
+    }
+
+    value = static_cast<T>(magnitude);
+  }
+
+  text.remove_prefix(position);
+
+  return true;
+}
+
+/**\n This function parses a list of decimal integers separated by the
+ * delimiter and appends them to the output. Returns false and leaves the
+ * output unchanged if any element is not a decimal integer fitting into T. */
+
+template<std::integral T>
+bool ParseIntegerList(std::string_view text, char delimiter, std::vector<T>& output) {
+  const size_t initial_size = output.size();
+  output.reserve(initial_size + std::count(text.begin(), text.end(), delimiter) + 1);
+
+  while (true) {
+    T value;
+
+    if (!ParseDecimalInteger(text, value)) {
+      output.resize(initial_size);
+      return false;
+    }
+
+    output.push_back(value);
+
+    if (text.empty()) {
+      return true;
+    }
+
+    if (text[0] != delimiter) {
+      output.resize(initial_size);
+      return false;
+    }
+
+    text.remove_prefix(1);
+  }
+}
+
+}
+
+#endif //ARGPARSER_NUMERICPARSING_HPP_
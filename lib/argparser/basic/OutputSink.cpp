@@ -0,0 +1,37 @@
+#include <utility>
+
+#include "OutputSink.hpp"
+
+#if defined _WIN32 || defined _WIN64 || defined __CYGWIN__
+#include <io.h>
+#define ARGPARSER_WRITE _write
+#else
+#include <unistd.h>
+#define ARGPARSER_WRITE ::write
+#endif
+
+ArgumentParser::OutputSink::OutputSink(int file_descriptor) : file_descriptor_(file_descriptor) {}
+
+ArgumentParser::OutputSink::OutputSink(std::function<void(std::string_view)> callback)
+    : file_descriptor_(-1), callback_(std::move(callback)) {}
+
+void ArgumentParser::OutputSink::Write(std::string_view data) const {
+  if (callback_) {
+    callback_(data);
+    return;
+  }
+
+  while (!data.empty()) {
+    const auto written = ARGPARSER_WRITE(file_descriptor_, data.data(), static_cast<unsigned int>(data.size()));
+
+    if (written <= 0) {
+      return;
+    }
+
+    data.remove_prefix(static_cast<size_t>(written));
+  }
+}
+
+bool ArgumentParser::OutputSink::IsConsole() const {
+  return !callback_ && (file_descriptor_ == kStandardOutput || file_descriptor_ == kStandardError);
+}
@@ -0,0 +1,33 @@
+#ifndef ARGPARSER_OUTPUTSINK_HPP_
+#define ARGPARSER_OUTPUTSINK_HPP_
+
+#include <functional>
+#include <string_view>
+
+namespace ArgumentParser {
+
+/**\n This class is a lightweight output destination that does not depend on
+ * iostreams: data is either written to a file descriptor (standard output by
+ * default) or passed to a callback. */
+
+class OutputSink {
+ public:
+  static constexpr int kStandardOutput = 1;
+  static constexpr int kStandardError = 2;
+
+  OutputSink() = default;
+  explicit OutputSink(int file_descriptor);
+  explicit OutputSink(std::function<void(std::string_view)> callback);
+
+  void Write(std::string_view data) const;
+
+  [[nodiscard]] bool IsConsole() const;
+
+ private:
+  int file_descriptor_ = kStandardOutput;
+  std::function<void(std::string_view)> callback_;
+};
+
+}
+
+#endif //ARGPARSER_OUTPUTSINK_HPP_
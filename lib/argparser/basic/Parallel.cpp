@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#include "Parallel.hpp"
+
+namespace {
+
+/* A call of ParallelFor is a batch of chunks. The calling thread and the
+ * workers of the pool claim its chunks one by one until none is left, so a
+ * batch completes even if all workers are busy with other batches. */
+
+struct Batch {
+  const std::function<void(size_t, size_t)>* body;
+  size_t count;
+  size_t chunk_size;
+  size_t chunks;
+  std::atomic<size_t> next_chunk = 0;
+  size_t finished_chunks = 0;
+  std::exception_ptr exception;
+  std::mutex mutex;
+  std::condition_variable is_finished;
+
+  /* An exception of a chunk is kept and rethrown by the caller of
+   * ParallelFor, the chunk still counts as finished. */
+
+  void RunChunks() {
+    for (size_t chunk = next_chunk++; chunk < chunks; chunk = next_chunk++) {
+      const size_t begin = chunk * chunk_size;
+      std::exception_ptr chunk_exception;
+
+      try {
+        (*body)(begin, std::min(begin + chunk_size, count));
+      } catch (...) {
+        chunk_exception = std::current_exception();
+      }
+
+      std::lock_guard lock(mutex);
+
+      if (chunk_exception && !exception) {
+        exception = chunk_exception;
+      }
+
+      if (++finished_chunks == chunks) {
+        is_finished.notify_all();
+      }
+    }
+  }
+};
+
+thread_local bool is_pool_worker = false;
+
+/* The pool is created on the first parallel call and lives until the end of
+ * the program; its workers are detached and wait for batches. */
+
+class ThreadPool {
+ public:
+  /* If a thread cannot be started, the pool keeps the workers it has; the
+   * callers claim the chunks left over themselves. */
+
+  explicit ThreadPool(size_t workers) {
+    try {
+      for (size_t i = 0; i < workers; ++i) {
+        std::thread([this] { Work(); }).detach();
+      }
+    } catch (const std::system_error&) {
+    }
+  }
+
+  void Submit(const std::shared_ptr<Batch>& batch) {
+    {
+      std::lock_guard lock(mutex_);
+      batches_.push_back(batch);
+    }
+
+    has_batches_.notify_all();
+  }
+
+  void Retire(const std::shared_ptr<Batch>& batch) {
+    std::lock_guard lock(mutex_);
+    std::erase(batches_, batch);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable has_batches_;
+  std::deque<std::shared_ptr<Batch>> batches_;
+
+  void Work() {
+    is_pool_worker = true;
+
+    while (true) {
+      std::shared_ptr<Batch> batch;
+
+      {
+        std::unique_lock lock(mutex_);
+        has_batches_.wait(lock, [this] { return !batches_.empty(); });
+        batch = batches_.front();
+      }
+
+      batch->RunChunks();
+      Retire(batch);
+    }
+  }
+};
+
+size_t GetHardwareThreads() {
+  static const size_t hardware_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  return hardware_threads;
+}
+
+ThreadPool& GetThreadPool() {
+  static ThreadPool* const pool = new ThreadPool(GetHardwareThreads() - 1);
+  return *pool;
+}
+
+}
+
+void ArgumentParser::ParallelFor(size_t count, size_t minimum_chunk, const std::function<void(size_t, size_t)>& body) {
+  const size_t chunks = std::min(GetHardwareThreads(), count / std::max<size_t>(minimum_chunk, 1));
+
+  /* A body that calls ParallelFor again runs its range on the same worker,
+   * otherwise all workers could wait for chunks queued behind them. */
+
+  if (chunks <= 1 || is_pool_worker) {
+    if (count != 0) {
+      body(0, count);
+    }
+
+    return;
+  }
+
+  const size_t chunk_size = (count + chunks - 1) / chunks;
+  const auto batch = std::make_shared<Batch>();
+  batch->body = &body;
+  batch->count = count;
+  batch->chunk_size = chunk_size;
+  batch->chunks = (count + chunk_size - 1) / chunk_size;
+
+  ThreadPool& pool = GetThreadPool();
+  pool.Submit(batch);
+  batch->RunChunks();
+  pool.Retire(batch);
+
+  std::unique_lock lock(batch->mutex);
+  batch->is_finished.wait(lock, [&batch] { return batch->finished_chunks == batch->chunks; });
+
+  if (batch->exception) {
+    std::rethrow_exception(batch->exception);
+  }
+}
@@ -0,0 +1,20 @@
+#ifndef ARGPARSER_PARALLEL_HPP_
+#define ARGPARSER_PARALLEL_HPP_
+
+#include <cstddef>
+#include <functional>
+
+namespace ArgumentParser {
+
+/**\n This function splits the range [0, count) into contiguous chunks of at
+ * least minimum_chunk elements and calls body(begin, end) for each of them
+ * on the threads of a pool, which is created on the first call and reused
+ * by all later ones. The calling thread processes chunks as well. If the
+ * range is too small, body is called once on the calling thread. If body
+ * throws, the first exception is rethrown after all chunks have finished. */
+
+void ParallelFor(size_t count, size_t minimum_chunk, const std::function<void(size_t, size_t)>& body);
+
+}
+
+#endif //ARGPARSER_PARALLEL_HPP_
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <filesystem>
+
+#include "PathCache.hpp"
+#include "Parallel.hpp"
+
+namespace {
+
+thread_local ArgumentParser::PathCache* active_cache = nullptr;
+
+}
+
+void ArgumentParser::PathCache::Prefetch(const std::vector<std::string_view>& paths) {
+  std::vector<std::string_view>& unique_paths = prefetched_paths_;
+  std::vector<PathKind>& kinds = prefetched_kinds_;
+  unique_paths.clear();
+
+  {
+    std::lock_guard lock(mutex_);
+
+    for (const std::string_view& path : paths) {
+      if (!path.empty() && !kinds_.contains(path)) {
+        unique_paths.push_back(path);
+      }
+    }
+  }
+
+  /* Sorting deduplicates the batch in place, without a set of seen paths. */
+
+  std::ranges::sort(unique_paths);
+  unique_paths.erase(std::ranges::unique(unique_paths).begin(), unique_paths.end());
+  kinds.resize(unique_paths.size());
+
+  ParallelFor(unique_paths.size(), kMinimumPathsPerThread, [&unique_paths, &kinds](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      kinds[i] = GetPathKind(std::string(unique_paths[i]));
+    }
+  });
+
+  std::lock_guard lock(mutex_);
+
+  for (size_t i = 0; i < unique_paths.size(); ++i) {
+    kinds_.emplace(unique_paths[i], kinds[i]);
+  }
+}
+
+ArgumentParser::PathKind ArgumentParser::PathCache::GetKind(const std::string& path) {
+  {
+    std::lock_guard lock(mutex_);
+    const auto it = kinds_.find(path);
+
+    if (it != kinds_.end()) {
+      return it->second;
+    }
+  }
+
+  const PathKind kind = GetPathKind(path);
+  std::lock_guard lock(mutex_);
+  kinds_.emplace(path, kind);
+
+  return kind;
+}
+
+void ArgumentParser::PathCache::Clear() {
+  std::lock_guard lock(mutex_);
+  kinds_.clear();
+}
+
+size_t ArgumentParser::PathCache::GetSize() const {
+  std::lock_guard lock(mutex_);
+  return kinds_.size();
+}
+
+ArgumentParser::PathCache* ArgumentParser::PathCache::GetActive() {
+  return active_cache;
+}
+
+ArgumentParser::ScopedPathCache::ScopedPathCache(PathCache& cache) : previous_(active_cache) {
+  active_cache = &cache;
+}
+
+ArgumentParser::ScopedPathCache::~ScopedPathCache() {
+  active_cache = previous_;
+}
+
+ArgumentParser::PathKind ArgumentParser::GetPathKind(const std::string& path) {
+  std::error_code error_code;
+  const std::filesystem::file_status status = std::filesystem::status(path, error_code);
+
+  switch (status.type()) {
+    case std::filesystem::file_type::regular:
+      return PathKind::kRegularFile;
+    case std::filesystem::file_type::directory:
+      return PathKind::kDirectory;
+    case std::filesystem::file_type::not_found:
+    case std::filesystem::file_type::none:
+      return PathKind::kNotFound;
+    default:
+      return PathKind::kOther;
+  }
+}
@@ -0,0 +1,76 @@
+#ifndef ARGPARSER_PATHCACHE_HPP_
+#define ARGPARSER_PATHCACHE_HPP_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ArgumentParser {
+
+enum class PathKind : uint8_t {
+  kNotFound,
+  kRegularFile,
+  kDirectory,
+  kOther
+};
+
+/**\n This class caches the types of filesystem paths. Prefetch deduplicates
+ * a batch of paths and queries the filesystem for them in parallel, GetKind
+ * returns a cached value or queries the filesystem on a miss. The buffers of
+ * Prefetch are reused, so a batch allocates only for the new cache entries
+ * and the queries. Prefetch must not be called from several threads at once. */
+
+class PathCache {
+ public:
+  static constexpr size_t kMinimumPathsPerThread = 64;
+
+  void Prefetch(const std::vector<std::string_view>& paths);
+  PathKind GetKind(const std::string& path);
+  void Clear();
+
+  [[nodiscard]] size_t GetSize() const;
+
+  /**\n This function returns the cache activated on the current thread by
+   * ScopedPathCache, or nullptr. */
+
+  static PathCache* GetActive();
+
+ private:
+  struct StringHash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view value) const {
+      return std::hash<std::string_view>{}(value);
+    }
+  };
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, PathKind, StringHash, std::equal_to<>> kinds_;
+  std::vector<std::string_view> prefetched_paths_;
+  std::vector<PathKind> prefetched_kinds_;
+};
+
+/**\n This class activates a path cache on the current thread for its
+ * lifetime, so IsRegularFile and IsDirectory use it. */
+
+class ScopedPathCache {
+ public:
+  explicit ScopedPathCache(PathCache& cache);
+  ScopedPathCache(const ScopedPathCache& other) = delete;
+  ScopedPathCache& operator=(const ScopedPathCache& other) = delete;
+  ~ScopedPathCache();
+
+ private:
+  PathCache* previous_;
+};
+
+/**\n This function queries the filesystem for the type of the path. */
+
+PathKind GetPathKind(const std::string& path);
+
+}
+
+#endif //ARGPARSER_PATHCACHE_HPP_
@@ -0,0 +1,89 @@
+#ifndef ARGPARSER_SLOTBITSET_HPP_
+#define ARGPARSER_SLOTBITSET_HPP_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ArgumentParser {
+
+/**\n This class is a growable set of bits addressed by slot numbers. All bits
+ * are stored in 64-bit words of a single vector. */
+
+class SlotBitset {
+ public:
+  static constexpr size_t kBitsPerWord = 64;
+  static constexpr size_t kNoSlot = static_cast<size_t>(-1);
+
+  void Resize(size_t size) {
+    words_.resize((size + kBitsPerWord - 1) / kBitsPerWord);
+    size_ = size;
+  }
+
+  void Set(size_t slot, bool value = true) {
+    const uint64_t mask = uint64_t{1} << (slot % kBitsPerWord);
+
+    if (value) {
+      words_[slot / kBitsPerWord] |= mask;
+    } else {
+      words_[slot / kBitsPerWord] &= ~mask;
+    }
+  }
+
+  [[nodiscard]] bool Test(size_t slot) const {
+    return (words_[slot / kBitsPerWord] >> (slot % kBitsPerWord)) & 1;
+  }
+
+  /**\n This method returns the first slot set in both bitsets, or kNoSlot.
+   * The bitsets must have the same size. */
+
+  [[nodiscard]] size_t FindFirstCommon(const SlotBitset& other) const {
+    for (size_t i = 0; i < words_.size(); ++i) {
+      if ((words_[i] & other.words_[i]) != 0) {
+        return i * kBitsPerWord + static_cast<size_t>(std::countr_zero(words_[i] & other.words_[i]));
+      }
+    }
+
+    return kNoSlot;
+  }
+
+  /**\n This method returns the first slot set in the other bitset but not in
+   * this one, or kNoSlot. The bitsets must have the same size. */
+
+  [[nodiscard]] size_t FindFirstMissing(const SlotBitset& other) const {
+    for (size_t i = 0; i < words_.size(); ++i) {
+      if ((other.words_[i] & ~words_[i]) != 0) {
+        return i * kBitsPerWord + static_cast<size_t>(std::countr_zero(other.words_[i] & ~words_[i]));
+      }
+    }
+
+    return kNoSlot;
+  }
+
+  [[nodiscard]] size_t CountCommon(const SlotBitset& other) const {
+    size_t count = 0;
+
+    for (size_t i = 0; i < words_.size(); ++i) {
+      count += static_cast<size_t>(std::popcount(words_[i] & other.words_[i]));
+    }
+
+    return count;
+  }
+
+  [[nodiscard]] size_t GetSize() const {
+    return size_;
+  }
+
+  [[nodiscard]] size_t GetMemoryUsage() const {
+    return words_.capacity() * sizeof(uint64_t);
+  }
+
+ private:
+  std::vector<uint64_t> words_;
+  size_t size_ = 0;
+};
+
+}
+
+#endif //ARGPARSER_SLOTBITSET_HPP_
@@ -0,0 +1,95 @@
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "StringPool.hpp"
+
+namespace {
+
+constexpr size_t kChunkSize = 4096;
+
+/* Strings are copied into chunks which are never moved or freed while the
+ * program runs, so the views into them stay valid. */
+
+class Storage {
+ public:
+  std::string_view Intern(std::string_view value) {
+    {
+      std::shared_lock lock(mutex_);
+      const auto it = index_.find(value);
+
+      if (it != index_.end()) {
+        return *it;
+      }
+    }
+
+    std::unique_lock lock(mutex_);
+    const auto it = index_.find(value);
+
+    if (it != index_.end()) {
+      return *it;
+    }
+
+    const std::string_view stored = Store(value);
+    index_.insert(stored);
+
+    return stored;
+  }
+
+  size_t GetMemoryUsage() {
+    std::shared_lock lock(mutex_);
+    return memory_usage_ + index_.bucket_count() * sizeof(void*) +
+        index_.size() * (sizeof(std::string_view) + 2 * sizeof(void*));
+  }
+
+ private:
+  std::shared_mutex mutex_;
+  std::unordered_set<std::string_view> index_;
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  size_t chunk_used_ = kChunkSize;
+  size_t memory_usage_ = 0;
+
+  std::string_view Store(std::string_view value) {
+    if (value.empty()) {
+      return {""};
+    }
+
+    if (value.size() > kChunkSize / 4) {
+      chunks_.push_back(std::make_unique<char[]>(value.size()));
+      memory_usage_ += value.size();
+      std::copy(value.begin(), value.end(), chunks_.back().get());
+      chunk_used_ = kChunkSize;
+
+      return {chunks_.back().get(), value.size()};
+    }
+
+    if (chunk_used_ + value.size() > kChunkSize) {
+      chunks_.push_back(std::make_unique<char[]>(kChunkSize));
+      memory_usage_ += kChunkSize;
+      chunk_used_ = 0;
+    }
+
+    char* destination = chunks_.back().get() + chunk_used_;
+    std::copy(value.begin(), value.end(), destination);
+    chunk_used_ += value.size();
+
+    return {destination, value.size()};
+  }
+};
+
+Storage& GetStorage() {
+  static Storage storage;
+  return storage;
+}
+
+}
+
+std::string_view ArgumentParser::StringPool::Intern(std::string_view value) {
+  return GetStorage().Intern(value);
+}
+
+size_t ArgumentParser::StringPool::GetMemoryUsage() {
+  return GetStorage().GetMemoryUsage();
+}
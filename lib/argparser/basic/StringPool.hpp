@@ -0,0 +1,25 @@
+#ifndef ARGPARSER_STRINGPOOL_HPP_
+#define ARGPARSER_STRINGPOOL_HPP_
+
+#include <cstddef>
+#include <string_view>
+
+namespace ArgumentParser {
+
+/**\n This class is a process-wide append-only pool of strings. Equal strings
+ * are stored once, the returned views stay valid until the end of the
+ * program, so the metadata of arguments can be copied as a pointer. All
+ * functions are thread-safe. */
+
+class StringPool {
+ public:
+  StringPool() = delete;
+
+  static std::string_view Intern(std::string_view value);
+
+  [[nodiscard]] static size_t GetMemoryUsage();
+};
+
+}
+
+#endif //ARGPARSER_STRINGPOOL_HPP_
@@ -0,0 +1,135 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.hpp"
+
+namespace {
+
+std::atomic<size_t> allocations = 0;
+
+void* Allocate(size_t size) noexcept {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+/* std::aligned_alloc is not available with MSVC, so an aligned block is cut
+ * out of a larger one and the pointer to the larger one is kept right before
+ * the aligned block. */
+
+void* AllocateAligned(size_t size, std::align_val_t alignment) noexcept {
+  const auto align = static_cast<size_t>(alignment);
+  void* raw_pointer = Allocate(size + align + sizeof(void*));
+
+  if (raw_pointer == nullptr) {
+    return nullptr;
+  }
+
+  const uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw_pointer) + sizeof(void*) + align - 1) & ~(align - 1);
+  reinterpret_cast<void**>(aligned)[-1] = raw_pointer;
+
+  return reinterpret_cast<void*>(aligned);
+}
+
+void DeallocateAligned(void* pointer) noexcept {
+  if (pointer != nullptr) {
+    std::free(static_cast<void**>(pointer)[-1]);
+  }
+}
+
+void* CheckAllocation(void* pointer) {
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return pointer;
+}
+
+}
+
+void* operator new(size_t size) {
+  return CheckAllocation(Allocate(size));
+}
+
+void* operator new[](size_t size) {
+  return CheckAllocation(Allocate(size));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  return CheckAllocation(AllocateAligned(size, alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return CheckAllocation(AllocateAligned(size, alignment));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return AllocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return AllocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  DeallocateAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+  DeallocateAligned(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+  DeallocateAligned(pointer);
+}
+
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept {
+  DeallocateAligned(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+  DeallocateAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+  DeallocateAligned(pointer);
+}
+
+AllocationCounter::AllocationCounter() : initial_allocations_(allocations.load(std::memory_order_relaxed)) {}
+
+size_t AllocationCounter::GetAllocations() const {
+  return allocations.load(std::memory_order_relaxed) - initial_allocations_;
+}
@@ -0,0 +1,22 @@
+#ifndef ALLOCATIONCOUNTER_HPP_
+#define ALLOCATIONCOUNTER_HPP_
+
+#include <cstddef>
+
+/* The tests and the corpus replay benchmark replace all forms of the global
+ * operator new (plain, nothrow and aligned), so that the number of
+ * allocations made by a piece of code can be asserted or reported. An object
+ * of this class counts the allocations made by all threads since its
+ * creation. */
+
+class AllocationCounter {
+ public:
+  AllocationCounter();
+
+  [[nodiscard]] size_t GetAllocations() const;
+
+ private:
+  size_t initial_allocations_;
+};
+
+#endif //ALLOCATIONCOUNTER_HPP_
@@ -1,7 +1,15 @@
+#include <deque>
+#include <fstream>
+#include <memory_resource>
+#include <set>
 #include <sstream>
+#include <thread>
 
 #include "lib/argparser/ArgParser.hpp"
+#include "lib/argparser/StreamingParser.hpp"
+#include "lib/argparser/basic/ByteScan.hpp"
 #include "test_functions.hpp"
+#include "AllocationCounter.hpp"
 #include "ArgParserUnitTestSuite.hpp"
 #include <gtest/gtest.h>
 
@@ -278,3 +286,1086 @@ TEST_F(ArgParserUnitTestSuite, NonMemberParsingTest) {
   ASSERT_TRUE(parser.GetFlag("test"));
   ASSERT_TRUE(parser.GetValue<Action>("action") == Action::kSum);
 }
+
+TEST_F(ArgParserUnitTestSuite, EnvironmentFallbackTest) {
+  ArgParser parser("My Parser");
+  parser.AddIntArgument("number", "Some Number").FromEnvironment("ARGPARSER_TEST_NUMBER");
+  SetTestEnvironment("ARGPARSER_TEST_NUMBER", "42");
+
+  ASSERT_TRUE(parser.Parse(SplitString("app")));
+  ASSERT_EQ(parser.GetIntValue("number"), 42);
+  ASSERT_TRUE(parser.Parse(SplitString("app --number=7")));
+  ASSERT_EQ(parser.GetIntValue("number"), 7);
+
+  /* An option used without its value fails instead of taking the fallback. */
+
+  ASSERT_FALSE(parser.Parse(SplitString("app --number")));
+  ClearTestEnvironment("ARGPARSER_TEST_NUMBER");
+}
+
+TEST_F(ArgParserUnitTestSuite, SharedEnvironmentTest) {
+  ArgParser parser("My Parser");
+  std::vector<int> values;
+  parser.AddIntArgument("number", "Some Number").FromEnvironment("ARGPARSER_TEST_SHARED");
+  parser.AddStringArgument("name", "Some Name").FromEnvironment("ARGPARSER_TEST_SHARED");
+  parser.AddIntArgument("values", "Some Values").MultiValue().StoreValues(values).FromEnvironment("ARGPARSER_TEST_SHARED");
+  SetTestEnvironment("ARGPARSER_TEST_SHARED", "17");
+
+  ASSERT_TRUE(parser.Parse(SplitString("app --name=other")));
+  ASSERT_EQ(parser.GetIntValue("number"), 17);
+  ASSERT_EQ(parser.GetStringValue("name"), "other");
+  ASSERT_EQ(values, std::vector<int>({17}));
+
+  ASSERT_TRUE(parser.Parse(SplitString("app")));
+  ASSERT_EQ(parser.GetStringValue("name"), "17");
+  ClearTestEnvironment("ARGPARSER_TEST_SHARED");
+}
+
+TEST_F(ArgParserUnitTestSuite, ConfigFileFallbackTest) {
+  const std::string config_name = kTemporaryDirectoryName + "/config.ini";
+  const std::string snapshot_name = kTemporaryDirectoryName + "/config.bin";
+  std::ofstream(config_name) << "# comment\nnumber = 5\nname = \"some name\"\nvalues=1\nvalues=2\n";
+
+  ArgParser parser("My Parser");
+  std::vector<int> values;
+  parser.AddIntArgument("number", "Some Number").FromEnvironment("ARGPARSER_TEST_CONFIG_NUMBER");
+  parser.AddStringArgument("name", "Some Name");
+  parser.AddIntArgument("values", "Some Values").MultiValue(2).StoreValues(values);
+
+  ASSERT_TRUE(parser.ReadConfig(config_name));
+  ASSERT_TRUE(parser.Parse(SplitString("app --name=other")));
+  ASSERT_EQ(parser.GetIntValue("number"), 5);
+  ASSERT_EQ(parser.GetStringValue("name"), "other");
+  ASSERT_EQ(values, std::vector<int>({1, 2}));
+
+  SetTestEnvironment("ARGPARSER_TEST_CONFIG_NUMBER", "6");
+  ASSERT_TRUE(parser.Parse(SplitString("app")));
+  ASSERT_EQ(parser.GetIntValue("number"), 6);
+  ASSERT_EQ(parser.GetStringValue("name"), "some name");
+  ClearTestEnvironment("ARGPARSER_TEST_CONFIG_NUMBER");
+
+  ASSERT_TRUE(parser.WriteConfigSnapshot(snapshot_name));
+
+  ArgParser snapshot_parser("My Parser");
+  snapshot_parser.AddIntArgument("number", "Some Number");
+  snapshot_parser.AddStringArgument("name", "Some Name");
+  snapshot_parser.AddIntArgument("values", "Some Values").MultiValue(2);
+
+  ASSERT_TRUE(snapshot_parser.ReadConfig(snapshot_name));
+  ASSERT_TRUE(snapshot_parser.Parse(SplitString("app")));
+  ASSERT_EQ(snapshot_parser.GetIntValue("number"), 5);
+  ASSERT_EQ(snapshot_parser.GetStringValue("name"), "some name");
+}
+
+TEST_F(ArgParserUnitTestSuite, ExportImportStateTest) {
+  ArgParser parser("My Parser");
+  std::vector<int> values;
+  parser.AddStringArgument('s', "string", "Some String");
+  parser.AddFlag('f', "flag", "Some Flag");
+  parser.AddDoubleArgument("ratio", "Some Ratio").Default(0.5);
+  parser.AddIntArgument("N", "Some Numbers").MultiValue(1).Positional().StoreValues(values);
+
+  ASSERT_TRUE(parser.Parse(SplitString("app -f --string=value 1 2 3")));
+  const std::string state = parser.ExportState();
+  ASSERT_FALSE(state.empty());
+
+  ArgParser worker("My Parser");
+  std::vector<int> worker_values;
+  worker.AddStringArgument('s', "string", "Some String");
+  worker.AddFlag('f', "flag", "Some Flag");
+  worker.AddDoubleArgument("ratio", "Some Ratio").Default(0.5);
+  worker.AddIntArgument("N", "Some Numbers").MultiValue(1).Positional().StoreValues(worker_values);
+
+  ASSERT_TRUE(worker.ImportState(state));
+  ASSERT_EQ(worker.GetStringValue("string"), "value");
+  ASSERT_TRUE(worker.GetFlag("flag"));
+  ASSERT_EQ(worker.GetDoubleValue("ratio"), 0.5);
+  ASSERT_EQ(worker_values, std::vector<int>({1, 2, 3}));
+  ASSERT_FALSE(worker.ImportState(state.substr(0, state.size() - 1)));
+
+  ArgParser other("Other Parser");
+  other.AddIntArgument("string", "Some String");
+
+  ASSERT_FALSE(other.ImportState(state));
+}
+
+TEST_F(ArgParserUnitTestSuite, ExportRawTypesTest) {
+  ArgParser parser("My Parser", PassArgumentTypes(Label, Coordinates));
+  parser.AddArgument<Coordinates>('p', "point", "Some Point");
+  parser.AddArgument<Size>("limit", "Some Limit").Default(Size{1024});
+
+  ASSERT_TRUE(parser.Parse(SplitString("app -p 3,4")));
+  const std::string state = parser.ExportState();
+  ASSERT_FALSE(state.empty());
+
+  ArgParser worker("My Parser", PassArgumentTypes(Label, Coordinates));
+  worker.AddArgument<Coordinates>('p', "point", "Some Point");
+  worker.AddArgument<Size>("limit", "Some Limit").Default(Size{1024});
+
+  ASSERT_TRUE(worker.ImportState(state));
+  ASSERT_EQ(worker.GetValue<Coordinates>("point").y, 4);
+  ASSERT_EQ(worker.GetValue<Size>("limit").bytes, 1024);
+
+  /* A string_view would point into the memory of the exporting process. */
+  parser.AddArgument<Label>('l', "label", "Some Label");
+
+  ASSERT_TRUE(parser.Parse(SplitString("app -p 3,4 -l text")));
+  ASSERT_TRUE(parser.ExportState().empty());
+}
+
+TEST_F(ArgParserUnitTestSuite, TruncatedArgumentsTest) {
+  ArgParser parser("My Parser");
+  parser.AddStringArgument('s', "string", "Some String").Default("default");
+  parser.AddFlag('a', "all", "Some Flag");
+  parser.AddCompositeArgument('i', "input", "Some Path").AddValidate(&IsValidFilename).Default("none");
+
+  ASSERT_TRUE(parser.Parse(std::vector<std::string>{"app", "", "\""}));
+  ASSERT_FALSE(parser.Parse(SplitString("app --string")));
+  ASSERT_FALSE(parser.Parse(SplitString("app --string -- value")));
+  ASSERT_TRUE(parser.Parse(std::vector<std::string>{"app", "-i", ""}));
+  ASSERT_EQ(parser.GetCompositeValue("input"), "");
+
+  ASSERT_TRUE(parser.Parse(SplitString("app -as value")));
+  ASSERT_TRUE(parser.GetFlag("all"));
+  ASSERT_EQ(parser.GetStringValue("string"), "value");
+}
+
+TEST_F(ArgParserUnitTestSuite, MemoryUsageTest) {
+  ArgParser parser("My Parser");
+  parser.AddHelp('h', "help", "Some Description about program");
+  const MemoryUsageReport empty_report = parser.MemoryUsage();
+
+  parser.AddIntArgument('n', "number", "Some Number").Default(1);
+  parser.AddStringArgument('s', "string", "Some String").MultiValue();
+
+  const MemoryUsageReport built_report = parser.MemoryUsage();
+  ASSERT_GT(built_report.builders, empty_report.builders);
+  ASSERT_GT(built_report.lookup_tables, empty_report.lookup_tables);
+  ASSERT_EQ(built_report.arguments, 0);
+
+  ASSERT_TRUE(parser.Parse(SplitString("app -s a -s b")));
+
+  const MemoryUsageReport parsed_report = parser.MemoryUsage();
+  ASSERT_GT(parsed_report.arguments, 0);
+  ASSERT_LT(parsed_report.arguments, parsed_report.builders);
+  ASSERT_GT(parsed_report.stored_values, 0);
+  ASSERT_EQ(parsed_report.Total(),
+            parsed_report.parser + parsed_report.builders + parsed_report.arguments + parsed_report.stored_values
+                + parsed_report.lookup_tables + parsed_report.type_names);
+}
+
+TEST_F(ArgParserUnitTestSuite, OnDemandTypesTest) {
+  ArgParser parser("My Parser");
+  parser.AddHelp('h', "help", "Some Description about program");
+  parser.AddIntArgument('n', "number", "Some Number").Default(1);
+  const MemoryUsageReport base_report = parser.MemoryUsage();
+
+  parser.SetAliasForType<Size>("bytes");
+  parser.AddSizeArgument("limit", "Some Limit").Default(Size{1024});
+  parser.AddSizeArgument("buffer", "Some Buffer").Default(Size{4096});
+
+  ASSERT_GT(parser.MemoryUsage().type_names, base_report.type_names);
+  ASSERT_NE(parser.HelpDescription().find("--limit=<bytes>"), std::string::npos);
+  ASSERT_TRUE(parser.Parse(SplitString("app --limit=2KiB")));
+  ASSERT_EQ(parser.GetSizeValue("limit").bytes, 2048);
+  ASSERT_THROW(parser.GetDurationValue("limit"), std::out_of_range);
+}
+
+TEST_F(ArgParserUnitTestSuite, InternedStringsTest) {
+  ArgParser first_parser("My Parser");
+  ArgParser second_parser("My Parser");
+  auto* long_name = new std::string("number");
+  auto* description = new std::string("Some Number");
+  auto& first_builder = first_parser.AddIntArgument(*long_name, *description);
+  auto& second_builder = second_parser.AddIntArgument(*long_name, *description);
+  delete long_name;
+  delete description;
+
+  ASSERT_EQ(first_builder.GetInfo().description.data(), second_builder.GetInfo().description.data());
+  ASSERT_EQ(first_builder.GetInfo().long_key.data(), second_builder.GetInfo().long_key.data());
+  ASSERT_TRUE(first_parser.Parse(SplitString("app --number=1")));
+  ASSERT_EQ(first_parser.GetIntValue("number"), 1);
+
+  std::vector<std::thread> threads;
+  std::vector<std::string_view> results(8);
+
+  for (size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&results, i]() {
+      results[i] = StringPool::Intern("Interned from thread");
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (const std::string_view& result : results) {
+    ASSERT_EQ(result.data(), results[0].data());
+  }
+}
+
+TEST_F(ArgParserUnitTestSuite, PathCacheTest) {
+  std::string args = "app";
+  std::vector<std::string> files;
+
+  for (size_t i = 0; i < 200; ++i) {
+    files.push_back(kTemporaryDirectoryName + "/file" + std::to_string(i));
+    std::ofstream{files.back()};
+    args += " " + files.back() + " " + files.back();
+  }
+
+  ArgParser parser("My Parser");
+  std::vector<std::string> values;
+  parser.AddStringArgument("files", "Input files").MultiValue(1).Positional().StoreValues(values)
+      .AddIsGood(&IsRegularFile);
+  parser.AddStringArgument('o', "output", "Output directory").AddIsGood(&IsDirectory);
+
+  ASSERT_TRUE(parser.Parse(SplitString(args + " -o " + kTemporaryDirectoryName)));
+  ASSERT_EQ(values.size(), 400);
+  ASSERT_FALSE(parser.Parse(SplitString(args + " " + kTemporaryDirectoryName + "/missing -o "
+                                            + kTemporaryDirectoryName)));
+  ASSERT_FALSE(parser.Parse(SplitString(args + " -o " + kTemporaryFileName)));
+
+  PathCache cache;
+  cache.Prefetch({kTemporaryFileName, kTemporaryFileName, kTemporaryDirectoryName});
+  ASSERT_EQ(cache.GetSize(), 2);
+  ASSERT_EQ(cache.GetKind(kTemporaryFileName), PathKind::kRegularFile);
+  ASSERT_EQ(cache.GetKind(kTemporaryDirectoryName), PathKind::kDirectory);
+  ASSERT_EQ(cache.GetKind(kTemporaryDirectoryName + "/missing"), PathKind::kNotFound);
+}
+
+TEST_F(ArgParserUnitTestSuite, DelimitedValuesTest) {
+  ArgParser parser("My Parser");
+  std::vector<int64_t> ids;
+  std::vector<std::string> names;
+  parser.AddLongLongArgument("ids", "Some IDs").Delimited().MultiValue(1).StoreValues(ids);
+  parser.AddStringArgument('n', "names", "Some Names").Delimited(';').MultiValue().StoreValues(names);
+
+  ASSERT_TRUE(parser.Parse(SplitString("app --ids=17,42,-99,123456789012345 -n a;b --ids 0x10,010")));
+  ASSERT_EQ(ids, std::vector<int64_t>({17, 42, -99, 123456789012345, 16, 8}));
+  ASSERT_EQ(names, std::vector<std::string>({"a", "b"}));
+
+  std::string long_list;
+  std::vector<int64_t> expected;
+
+  for (int64_t i = 0; i < 10000; ++i) {
+    expected.push_back(i * 1000003 - 5000000);
+    long_list += (i == 0 ? "" : ",") + std::to_string(expected.back());
+  }
+
+  ASSERT_TRUE(parser.Parse(SplitString("app --ids=" + long_list)));
+  ASSERT_EQ(ids, expected);
+
+  ASSERT_FALSE(parser.Parse(SplitString("app --ids=1,x,3")));
+  ASSERT_FALSE(parser.Parse(SplitString("app --ids=1,,3")));
+  ASSERT_FALSE(parser.Parse(SplitString("app --ids=99999999999999999999")));
+}
+
+TEST_F(ArgParserUnitTestSuite, MappedArrayTest) {
+  const std::string weights_name = kTemporaryDirectoryName + "/weights.bin";
+  const std::string broken_name = kTemporaryDirectoryName + "/broken.bin";
+  const std::vector<float> weights = {0.5f, -1.25f, 3.0f, 1e-3f};
+  std::ofstream(weights_name, std::ios::binary).write(reinterpret_cast<const char*>(weights.data()),
+                                                      static_cast<std::streamsize>(weights.size() * sizeof(float)));
+  std::ofstream(broken_name, std::ios::binary) << "12345";
+
+  ArgParser parser("My Parser");
+  parser.AddHelp('h', "help", "Some Description about program");
+  parser.AddArgument<MappedArray<float>>('w', "weights", "Some Weights");
+
+  ASSERT_TRUE(parser.Parse(SplitString("app -w " + weights_name)));
+  const MappedArray<float> array = parser.GetValue<MappedArray<float>>("weights");
+  ASSERT_EQ(std::vector<float>(array.GetSpan().begin(), array.GetSpan().end()), weights);
+  ASSERT_EQ(array.GetPath(), weights_name);
+
+  const std::string state = parser.ExportState();
+  ASSERT_FALSE(state.empty());
+  ASSERT_TRUE(parser.ImportState(state));
+  ASSERT_EQ(parser.GetValue<MappedArray<float>>("weights").GetSize(), weights.size());
+
+  ASSERT_FALSE(parser.Parse(SplitString("app -w " + broken_name)));
+  ASSERT_FALSE(parser.Parse(SplitString("app -w " + kTemporaryDirectoryName + "/missing.bin")));
+  ASSERT_NE(parser.HelpDescription().find("--weights=<MappedArray<float>>"), std::string::npos);
+}
+
+TEST_F(ArgParserUnitTestSuite, ManyFlagsTest) {
+  ArgParser parser("My Parser");
+  const std::string short_keys = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+  std::vector<bool> repeated_values;
+
+  for (size_t i = 0; i < 150; ++i) {
+    auto& flag = i < short_keys.size() ? parser.AddFlag(short_keys[i], "flag" + std::to_string(i))
+                                       : parser.AddFlag("flag" + std::to_string(i));
+
+    if (i == 149) {
+      flag.Default(true);
+    }
+  }
+
+  parser.AddIntArgument('#', "number", "Some Number").Default(0);
+  parser.AddFlag("repeated", "Repeated Flag").MultiValue().StoreValues(repeated_values);
+
+  ASSERT_TRUE(parser.Parse(SplitString("app -acZ9 -#=5 --flag100 --flag149=false --repeated --repeated=false")));
+
+  for (size_t i = 0; i < 150; ++i) {
+    const bool is_set = i == 0 || i == 2 || i == 51 || i == 61 || i == 100;
+    ASSERT_EQ(parser.GetFlag("flag" + std::to_string(i)), is_set) << i;
+  }
+
+  ASSERT_EQ(parser.GetIntValue("number"), 5);
+  ASSERT_TRUE(parser.GetFlag("repeated"));
+  ASSERT_FALSE(parser.GetFlag("repeated", 1));
+
+  ASSERT_TRUE(parser.Parse(SplitString("app")));
+  ASSERT_FALSE(parser.GetFlag("flag0"));
+  ASSERT_TRUE(parser.GetFlag("flag149"));
+  ASSERT_FALSE(parser.Parse(SplitString("app -!")));
+}
+
+TEST_F(ArgParserUnitTestSuite, FlagStateTest) {
+  ArgParser parser("My Parser");
+  bool stored_flag = false;
+  std::vector<bool> repeated_values;
+  parser.AddFlag('v', "verbose", "Some Flag").StoreValue(stored_flag);
+  parser.AddFlag("color", "Some Flag").Default(true);
+  parser.AddFlag("repeated", "Repeated Flag").MultiValue().StoreValues(repeated_values);
+
+  ASSERT_TRUE(parser.Parse(SplitString("app -v --color=false --repeated=false --repeated")));
+  ASSERT_TRUE(stored_flag);
+  ASSERT_FALSE(parser.GetFlag("color"));
+  ASSERT_FALSE(parser.GetFlag("repeated"));
+  ASSERT_TRUE(parser.GetFlag("repeated", 1));
+
+  const std::string state = parser.ExportState();
+  ASSERT_TRUE(parser.Parse(SplitString("app")));
+  ASSERT_FALSE(stored_flag);
+  ASSERT_TRUE(parser.GetFlag("color"));
+
+  ASSERT_TRUE(parser.ImportState(state));
+  ASSERT_TRUE(stored_flag);
+  ASSERT_TRUE(parser.GetFlag("verbose"));
+  ASSERT_FALSE(parser.GetFlag("color"));
+  ASSERT_FALSE(parser.GetFlag("repeated"));
+  ASSERT_EQ(repeated_values, std::vector<bool>({false, true}));
+}
+
+TEST_F(ArgParserUnitTestSuite, StreamingParserTest) {
+  ArgParser parser("My Parser");
+  std::vector<int> values;
+  parser.AddIntArgument('n', "number", "Some Number");
+  parser.AddIntArgument("values", "Some Values").MultiValue(2).StoreValues(values);
+  parser.AddFlag('f', "flag", "Some Flag");
+
+  std::vector<std::string> received;
+  StreamingParser streaming_parser(parser, [&received](std::string_view value) {
+    received.emplace_back(value);
+    return true;
+  });
+
+  ASSERT_TRUE(streaming_parser.Feed(std::vector<std::string>{"first", "-n"}));
+  ASSERT_EQ(received, std::vector<std::string>({"first"}));
+  ASSERT_EQ(streaming_parser.GetPendingSize(), 1);
+
+  ASSERT_TRUE(streaming_parser.Feed("-5"));
+  ASSERT_TRUE(streaming_parser.Feed("second"));
+  ASSERT_EQ(received, std::vector<std::string>({"first", "second"}));
+  ASSERT_EQ(streaming_parser.GetPendingSize(), 0);
+
+  ASSERT_TRUE(streaming_parser.Feed(std::vector<std::string>{"--values", "1", "2"}));
+  ASSERT_EQ(streaming_parser.GetPendingSize(), 0);
+  ASSERT_EQ(values, std::vector<int>({1, 2}));
+  ASSERT_TRUE(streaming_parser.Feed(std::vector<std::string>{"-f", "third"}));
+  ASSERT_EQ(values, std::vector<int>({1, 2}));
+  ASSERT_EQ(received, std::vector<std::string>({"first", "second", "third"}));
+
+  ASSERT_FALSE(streaming_parser.Feed(std::vector<std::string>{"--", "ignored"}));
+  ASSERT_TRUE(streaming_parser.Finish());
+  ASSERT_EQ(parser.GetIntValue("number"), -5);
+  ASSERT_TRUE(parser.GetFlag("flag"));
+  ASSERT_EQ(received.size(), 3);
+
+  ArgParser positional_parser("My Parser");
+  positional_parser.AddStringArgument("files", "Some Files").Positional().MultiValue(1);
+  StreamingParser collecting_parser(positional_parser);
+
+  ASSERT_TRUE(collecting_parser.Feed(std::vector<std::string>{"a", "b"}));
+  ASSERT_TRUE(collecting_parser.Finish());
+  ASSERT_EQ(positional_parser.GetStringValue("files", 1), "b");
+
+  StreamingParser failing_parser(positional_parser);
+  ASSERT_FALSE(failing_parser.Feed("--unknown"));
+  ASSERT_FALSE(failing_parser.Finish());
+}
+
+TEST_F(ArgParserUnitTestSuite, StreamingLongRunTest) {
+  ArgParser parser("My Parser");
+  std::vector<int> values;
+  parser.AddIntArgument("values", "Some Values").MultiValue(1).StoreValues(values);
+  parser.AddFlag('f', "flag", "Some Flag");
+
+  std::vector<std::string> received;
+  StreamingParser streaming_parser(parser, [&received](std::string_view value) {
+    received.emplace_back(value);
+    return true;
+  });
+
+  ASSERT_TRUE(streaming_parser.Feed("--values"));
+  ASSERT_EQ(streaming_parser.GetPendingSize(), 1);
+
+  for (int i = 0; i < 100000; ++i) {
+    ASSERT_TRUE(streaming_parser.Feed(std::to_string(i)));
+    ASSERT_EQ(streaming_parser.GetPendingSize(), 0);
+    ASSERT_EQ(values.size(), static_cast<size_t>(i) + 1);
+  }
+
+  ASSERT_TRUE(streaming_parser.Feed(std::vector<std::string>{"-f", "last"}));
+  ASSERT_TRUE(streaming_parser.Finish());
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(values[i], static_cast<int>(i));
+  }
+
+  ASSERT_TRUE(parser.GetFlag("flag"));
+  ASSERT_EQ(received, std::vector<std::string>({"last"}));
+}
+
+TEST_F(ArgParserUnitTestSuite, ValueReferencesTest) {
+  ArgParser parser("My Parser");
+  std::vector<std::string> names;
+  parser.AddIntArgument("values", "Some Values").MultiValue().Delimited();
+  parser.AddStringArgument('n', "names", "Some Names").MultiValue().StoreValues(names);
+  parser.AddStringArgument("single", "Single String").Default("default");
+
+  std::string values_string = "--values=";
+
+  for (int i = 0; i < 100000; ++i) {
+    values_string += (i == 0 ? "" : ",") + std::to_string(i);
+  }
+
+  ASSERT_TRUE(parser.Parse(SplitString("app -n a -n b " + values_string)));
+
+  const std::span<const int32_t> values = parser.GetValues<int32_t>("values");
+  ASSERT_EQ(values.size(), 100000);
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(values[i], static_cast<int32_t>(i));
+  }
+
+  ASSERT_EQ(parser.GetValues<std::string>("names").data(), names.data());
+  ASSERT_EQ(&parser.GetValueReference<std::string>("names", 1), &names[1]);
+  ASSERT_EQ(parser.GetStringView("names", 0), "a");
+  ASSERT_EQ(parser.GetStringView("single"), "default");
+  ASSERT_TRUE(parser.GetValues<std::string>("single").empty());
+}
+
+TEST_F(ArgParserUnitTestSuite, ConstraintsTest) {
+  ArgParser parser("My Parser");
+  parser.AddFlag('a', "all", "All").Excludes("none");
+  parser.AddFlag('n', "none", "None");
+  parser.AddStringArgument("output", "Output").Default("").Requires("json");
+  parser.AddFlag("json", "Json").OneOf("format", true);
+  parser.AddFlag("xml", "Xml").OneOf("format");
+
+  ASSERT_TRUE(parser.Parse(SplitString("app -a --json --output=file")));
+  ASSERT_TRUE(parser.GetErrors().empty());
+
+  ASSERT_FALSE(parser.Parse(SplitString("app -an --json")));
+  ASSERT_EQ(parser.GetErrors().size(), 1);
+  ASSERT_EQ(parser.GetErrors()[0].kind, ParsingErrorKind::kExcludedArgument);
+  ASSERT_EQ(parser.GetErrors()[0].argument, "all");
+  ASSERT_EQ(parser.GetErrors()[0].related, "none");
+
+  ASSERT_FALSE(parser.Parse(SplitString("app --output=file --xml")));
+  ASSERT_EQ(parser.GetErrors().size(), 1);
+  ASSERT_EQ(parser.GetErrors()[0].kind, ParsingErrorKind::kMissingRequiredArgument);
+  ASSERT_EQ(parser.GetErrors()[0].related, "json");
+
+  ASSERT_FALSE(parser.Parse(SplitString("app --json --xml")));
+  ASSERT_EQ(parser.GetErrors().size(), 1);
+  ASSERT_EQ(parser.GetErrors()[0].kind, ParsingErrorKind::kGroupConflict);
+  ASSERT_EQ(parser.GetErrors()[0].related, "format");
+
+  std::ostringstream error_stream;
+  ASSERT_FALSE(parser.Parse(SplitString("app --unknown"), {error_stream, true}));
+  ASSERT_EQ(parser.GetErrors()[0].kind, ParsingErrorKind::kUnknownArgument);
+  ASSERT_EQ(error_stream.str(), "Used nonexistent argument: --unknown\n");
+
+  ASSERT_FALSE(parser.Parse(SplitString("app")));
+  ASSERT_EQ(parser.GetErrors()[0].kind, ParsingErrorKind::kMissingGroupArgument);
+}
+
+TEST_F(ArgParserUnitTestSuite, UnitValuesTest) {
+  ArgParser parser("My Parser");
+  parser.AddHelp('h', "help", "Some Description about program");
+  parser.AddSizeArgument("cache", "Cache Size").Default(Size{512 * 1024 * 1024});
+  parser.AddDurationArgument("timeout", "Timeout").Default(Duration{std::chrono::milliseconds(250)});
+  parser.AddRateArgument("rate", "Rate").Default(Rate{10000});
+
+  ASSERT_TRUE(parser.Parse(SplitString("app --cache=1.5GB --timeout 1.5h --rate=2.5M/s")));
+  ASSERT_EQ(parser.GetSizeValue("cache").bytes, 1500000000);
+  ASSERT_EQ(parser.GetDurationValue("timeout").value, std::chrono::minutes(90));
+  ASSERT_EQ(parser.GetRateValue("rate").per_second, 2500000);
+
+  ASSERT_FALSE(parser.Parse(SplitString("app --cache=16EiB")));
+  ASSERT_FALSE(parser.Parse(SplitString("app --cache=12XB")));
+  ASSERT_FALSE(parser.Parse(SplitString("app --timeout=10")));
+  ASSERT_FALSE(parser.Parse(SplitString("app --timeout=300y")));
+  ASSERT_FALSE(parser.Parse(SplitString("app --rate=1.")));
+  ASSERT_TRUE(parser.Parse(SplitString("app --cache=15EiB --timeout=0 --rate=0.001k")));
+  ASSERT_EQ(parser.GetRateValue("rate").per_second, 1);
+
+  ASSERT_EQ(FormatSize(Size{1024}), "1KiB");
+  ASSERT_EQ(FormatSize(Size{3000}), "3kB");
+  ASSERT_EQ(FormatSize(Size{1001}), "1001B");
+  ASSERT_EQ(FormatDuration(Duration{std::chrono::seconds(90)}), "90s");
+  ASSERT_EQ(FormatDuration(Duration{}), "0ns");
+
+  const std::string help = parser.HelpDescription();
+  ASSERT_NE(help.find("--cache=<size>:  Cache Size [default = 512MiB]"), std::string::npos);
+  ASSERT_NE(help.find("default = 250ms"), std::string::npos);
+  ASSERT_NE(help.find("default = 10k"), std::string::npos);
+}
+
+TEST_F(ArgParserUnitTestSuite, CompletionScriptTest) {
+  ArgParser parser("My Parser");
+  parser.AddHelp('h', "help", "Some Description about program");
+  parser.AddStringArgument('i', "input", "Input [file]").AddIsGood(IsRegularFile);
+  parser.AddStringArgument("output-dir", "It's a directory").AddIsGood(IsDirectory);
+  parser.AddIntArgument('n', "number", "Some Number").MultiValue();
+  parser.AddStringArgument("files", "Some Files").Positional().MultiValue().AddValidate(IsRegularFile);
+
+  const std::string bash = parser.CompletionScript(CompletionShell::kBash, "my-app");
+  ASSERT_NE(bash.find("_my_app_completion() {"), std::string::npos);
+  ASSERT_NE(bash.find("'--input'|'-i'|'--files') COMPREPLY=($(compgen -f -- \"$cur\")); return ;;"), std::string::npos);
+  ASSERT_NE(bash.find("'--output-dir') COMPREPLY=($(compgen -d -- \"$cur\")); return ;;"), std::string::npos);
+  ASSERT_NE(bash.find("compgen -W '--help -h --input -i --output-dir --number -n --files'"), std::string::npos);
+  ASSERT_NE(bash.find("complete -F _my_app_completion 'my-app'"), std::string::npos);
+
+  const std::string zsh = parser.CompletionScript(CompletionShell::kZsh, "my-app");
+  ASSERT_EQ(zsh.find("#compdef my-app\n"), 0);
+  ASSERT_NE(zsh.find("'(-i --input)'{-i,'--input='}'[Input \\[file\\]]:value:_files'"), std::string::npos);
+  ASSERT_NE(zsh.find("'--output-dir=''[It'\\''s a directory]:value:_files -/'"), std::string::npos);
+  ASSERT_NE(zsh.find("'*'{-n,'--number='}'[Some Number]:value:'"), std::string::npos);
+  ASSERT_NE(zsh.find("'*:value:_files'"), std::string::npos);
+
+  const std::string fish = parser.CompletionScript(CompletionShell::kFish, "my-app");
+  ASSERT_NE(fish.find("complete -c 'my-app' -s 'i' -l 'input' -d 'Input [file]' -r -F\n"), std::string::npos);
+  ASSERT_NE(fish.find("complete -c 'my-app' -s 'h' -l 'help' -d 'Some Description about program'\n"), std::string::npos);
+  ASSERT_EQ(fish.find("complete -c 'my-app' -f\n"), std::string::npos);
+}
+
+struct Point {
+  int x = 0;
+  int y = 0;
+};
+
+template<>
+struct ArgumentParser::ValueFormatter<Point> {
+  static std::string Format(const Point& value) {
+    return std::to_string(value.x) + ":" + std::to_string(value.y);
+  }
+};
+
+TEST_F(ArgParserUnitTestSuite, OutputSinkTest) {
+  std::string output;
+  const OutputSink sink([&output](std::string_view data) { output += data; });
+  sink.Write("Some ");
+  sink.Write("Text");
+
+  ASSERT_EQ(output, "Some Text");
+  ASSERT_FALSE(sink.IsConsole());
+  ASSERT_TRUE(OutputSink(OutputSink::kStandardError).IsConsole());
+
+  ASSERT_EQ(FormatValue(Point{1, 2}), "1:2");
+  ASSERT_EQ(FormatValue(1.5), "1.5");
+  ASSERT_EQ(FormatValue(1.0 / 3), "0.333333");
+  ASSERT_EQ(FormatValue(2.0f / 3), "0.666667");
+  ASSERT_EQ(FormatValue(1e20), "1e+20");
+  ASSERT_EQ(FormatValue(int64_t{-42}), "-42");
+  ASSERT_EQ(FormatValue(true), "1");
+  ASSERT_EQ(FormatValue('c'), "c");
+  ASSERT_EQ(FormatValue(std::string("text")), "text");
+  ASSERT_EQ(FormatValue(Size{2048}), "2KiB");
+}
+
+TEST_F(ArgParserUnitTestSuite, ArgumentTraitsTest) {
+  ArgParser parser("My Parser");
+  std::vector<int> values;
+  auto& files = parser.AddStringArgument('f', "files").MultiValue(2).Positional().AddIsGood(IsRegularFile);
+  auto& numbers = parser.AddIntArgument("numbers").StoreValues(values).Delimited(';').FromEnvironment("NUMBERS");
+  auto& flag = parser.AddFlag('v', "verbose");
+
+  const ArgumentTraits files_traits(files.GetInfo());
+  ASSERT_EQ(files_traits.short_key, 'f');
+  ASSERT_EQ(files_traits.minimum_values, 2);
+  ASSERT_TRUE(files_traits.Has(ArgumentTraits::kMultiValue));
+  ASSERT_TRUE(files_traits.Has(ArgumentTraits::kPositional));
+  ASSERT_TRUE(files_traits.Has(ArgumentTraits::kIsGood));
+  ASSERT_TRUE(files_traits.Has(ArgumentTraits::kPathCheck));
+  ASSERT_FALSE(files_traits.Has(ArgumentTraits::kFlag));
+
+  const ArgumentTraits numbers_traits(numbers.GetInfo());
+  ASSERT_EQ(numbers_traits.delimiter, ';');
+  ASSERT_TRUE(numbers_traits.Has(ArgumentTraits::kStoreValues));
+  ASSERT_TRUE(numbers_traits.Has(ArgumentTraits::kEnvironment));
+  ASSERT_FALSE(numbers_traits.Has(ArgumentTraits::kIsGood));
+
+  ASSERT_TRUE(ArgumentTraits(flag.GetInfo()).Has(ArgumentTraits::kFlag));
+
+  ASSERT_FALSE(parser.Parse(SplitString("app --numbers=1;2;3 -v")));
+  ASSERT_EQ(values, std::vector<int>({1, 2, 3}));
+  ASSERT_TRUE(parser.GetFlag("verbose"));
+  ASSERT_EQ(parser.GetErrors().size(), 1);
+  ASSERT_EQ(parser.GetErrors()[0].kind, ParsingErrorKind::kInsufficientArguments);
+  ASSERT_EQ(parser.GetErrors()[0].argument, "files");
+}
+
+TEST_F(ArgParserUnitTestSuite, MoveOnlyTypeTest) {
+  ArgParser parser("My Parser", PassArgumentTypes(LookupTable, CopyCounter));
+  std::vector<CopyCounter> counters;
+  parser.AddArgument<LookupTable>('t', "table").MultiValue(1);
+  parser.AddArgument<CopyCounter>('c', "counter").MultiValue().StoreValues(counters);
+  parser.AddArgument<CopyCounter>("label").Default(CopyCounter());
+
+  CopyCounter::copies = 0;
+  ASSERT_TRUE(parser.Parse(SplitString("app -t 1-3 2-7 -c a b c d e f g h --label=text")));
+  ASSERT_EQ(CopyCounter::copies, 0);
+
+  const std::span<const LookupTable> tables = parser.GetValues<LookupTable>("table");
+  ASSERT_EQ(tables.size(), 2);
+  ASSERT_EQ(*tables[0].values, std::vector<int>({1, 2, 3}));
+  ASSERT_EQ(tables[1].values->size(), 6);
+  ASSERT_EQ(parser.GetValueReference<LookupTable>("table").values->back(), 7);
+
+  ASSERT_EQ(counters.size(), 8);
+  ASSERT_EQ(counters.back().text, "h");
+  ASSERT_EQ(parser.GetValueReference<CopyCounter>("label").text, "text");
+
+  ASSERT_FALSE(parser.Parse(SplitString("app -t 17")));
+}
+
+TEST_F(ArgParserUnitTestSuite, PathScanTest) {
+  /* Matches are placed at every offset of texts longer than a vector, so
+   * that both the vector loop and the tail are checked. */
+
+  for (size_t size = 2; size < 80; ++size) {
+    for (size_t position = 0; position + 1 < size; ++position) {
+      std::string path(size, 'a');
+      path[position] = '/';
+      ASSERT_EQ(FindRepeatedSeparator(path), std::string_view::npos);
+      path[position + 1] = '/';
+      ASSERT_EQ(FindRepeatedSeparator(path), position);
+      path[position + 1] = '\\';
+      ASSERT_EQ(FindRepeatedSeparator(path), std::string_view::npos);
+      path[position] = '\\';
+      ASSERT_EQ(FindRepeatedSeparator(path), position);
+
+      std::string windows_path(size, 'Z');
+      ASSERT_EQ(FindNonWindowsPathSymbol(windows_path), std::string_view::npos);
+      windows_path[position] = (position % 2 == 0) ? ':' : '\xD0';
+      ASSERT_EQ(FindNonWindowsPathSymbol(windows_path), position);
+    }
+  }
+
+  ASSERT_EQ(FindNonWindowsPathSymbol("Some folder\\sub-folder_2\\file.txt"), std::string_view::npos);
+  ASSERT_EQ(FindNonWindowsPathSymbol("folder`name"), 6);
+  ASSERT_EQ(FindNonWindowsPathSymbol("folder{name"), 6);
+
+  ASSERT_TRUE(IsValidPath("file:///home/user/file.txt"));
+  ASSERT_FALSE(IsValidPath("file:///home//user/file.txt"));
+  ASSERT_FALSE(IsValidPath("file://"));
+
+  std::string filename = "file://relative/path.txt";
+  ASSERT_TRUE(IsValidFilename(filename));
+  ASSERT_EQ(filename, "relative/path.txt");
+
+  filename = "file://file://path.txt";
+  ASSERT_FALSE(IsValidFilename(filename));
+}
+
+TEST_F(ArgParserUnitTestSuite, ParallelConversionTest) {
+  ArgParser parser("My Parser");
+  std::vector<int64_t> values;
+  parser.AddLongLongArgument("N").MultiValue(1).Positional().StoreValues(values).ParallelConversion(1000);
+  parser.AddStringArgument('s', "strings").MultiValue().ParallelConversion(10);
+  parser.AddFlag('v', "verbose");
+
+  std::vector<std::string> args = {"app"};
+
+  for (int64_t i = 0; i < 100000; ++i) {
+    args.push_back(std::to_string(i * 7 + 1000));
+  }
+
+  args.emplace_back("-s");
+
+  for (size_t i = 0; i < 100; ++i) {
+    args.push_back("string" + std::to_string(i));
+  }
+
+  args.emplace_back("-v");
+
+  ASSERT_TRUE(parser.Parse(args));
+  ASSERT_EQ(values.size(), 100000);
+
+  for (int64_t i = 0; i < 100000; ++i) {
+    ASSERT_EQ(values[i], i * 7 + 1000);
+  }
+
+  const std::span<const std::string> strings = parser.GetValues<std::string>("strings");
+  ASSERT_EQ(strings.size(), 100);
+  ASSERT_EQ(strings[57], "string57");
+  ASSERT_TRUE(parser.GetFlag("verbose"));
+
+  args[50000] = "not-a-number";
+  ASSERT_FALSE(parser.Parse(args));
+  ASSERT_EQ(parser.GetErrors().size(), 1);
+  ASSERT_EQ(parser.GetErrors()[0].kind, ParsingErrorKind::kInvalidArgument);
+  ASSERT_EQ(parser.GetErrors()[0].argument, "N");
+
+  /* An exception of a check reaches the caller from any thread. */
+
+  ArgParser throwing_parser("My Parser");
+  throwing_parser.AddStringArgument("N").MultiValue().Positional().ParallelConversion(10)
+      .AddIsGood([](std::string& value) {
+        if (value == "1500") {
+          throw std::runtime_error("Some error");
+        }
+
+        return true;
+      });
+
+  args.resize(2000);
+  args[1500] = "1500";
+  ASSERT_THROW(static_cast<void>(throwing_parser.Parse(args)), std::runtime_error);
+}
+
+TEST_F(ArgParserUnitTestSuite, MapArgumentTest) {
+  ArgParser parser("My Parser");
+  FlatHashMap<int32_t> defines;
+  FlatHashMap<std::string> labels;
+  parser.AddIntArgument('D', "define").MultiValue().StoreMap(defines);
+  parser.AddStringArgument("label").MultiValue().StoreMap(labels, DuplicateKeys::kFirstWins);
+
+  std::vector<std::string> args = {"app", "--label=env=prod", "--label", "env=test", "--label=team=core=1"};
+
+  for (int32_t i = 0; i < 5000; ++i) {
+    args.emplace_back("-D");
+    args.push_back("key" + std::to_string(i) + "=" + std::to_string(i * 3));
+  }
+
+  args.emplace_back("-D");
+  args.emplace_back("key42=7");
+
+  ASSERT_TRUE(parser.Parse(args));
+  ASSERT_EQ(defines.GetSize(), 5000);
+  ASSERT_EQ(*defines.Find(std::string_view("key4999")), 14997);
+  ASSERT_EQ(*defines.Find("key42"), 7);
+  ASSERT_EQ(defines.Find("key5000"), nullptr);
+  ASSERT_EQ(defines.GetEntries()[1].key, "key1");
+  ASSERT_EQ(labels.GetSize(), 2);
+  ASSERT_EQ(*labels.Find("env"), "prod");
+  ASSERT_EQ(*labels.Find("team"), "core=1");
+
+  ASSERT_FALSE(parser.Parse({"app", "-D", "key=value"}));
+  ASSERT_FALSE(parser.Parse({"app", "-D", "novalue"}));
+  ASSERT_FALSE(parser.Parse({"app", "-D", "=1"}));
+  ASSERT_TRUE(parser.Parse({"app", "-D", "a=1", "b=2"}));
+  ASSERT_EQ(defines.GetSize(), 2);
+  ASSERT_TRUE(labels.IsEmpty());
+  ASSERT_TRUE(parser.ExportState().empty());
+
+  ArgParser strict_parser("Strict Parser");
+  FlatHashMap<double> weights;
+  strict_parser.AddDoubleArgument('w', "weight").MultiValue().Delimited().StoreMap(weights, DuplicateKeys::kError);
+
+  ASSERT_TRUE(strict_parser.Parse({"app", "-w", "a=0.5,b=1.5"}));
+  ASSERT_EQ(*weights.Find("b"), 1.5);
+  ASSERT_FALSE(strict_parser.Parse({"app", "-w", "a=0.5,a=1.5"}));
+  ASSERT_EQ(strict_parser.GetErrors()[0].kind, ParsingErrorKind::kInvalidArgument);
+  ASSERT_EQ(strict_parser.GetErrors()[0].argument, "weight");
+}
+
+TEST_F(ArgParserUnitTestSuite, UniqueValuesTest) {
+  ArgParser parser("My Parser");
+  std::deque<std::string> hosts;
+  std::set<int32_t> ports;
+  std::pmr::monotonic_buffer_resource resource;
+  std::pmr::vector<int64_t> sizes(&resource);
+  parser.AddStringArgument('H', "host").MultiValue(4).Unique().StoreValues(hosts);
+  parser.AddIntArgument('p', "port").MultiValue().Delimited().Unique().StoreValues(ports);
+  parser.AddLongLongArgument('s', "size").MultiValue().Delimited().StoreValues(sizes);
+  parser.AddLongLongArgument('N', "number").MultiValue().Unique().ParallelConversion(100);
+
+  std::vector<std::string> args = SplitString("app -H b a b -H c a -p 0x10,16,8,8 -p 8 -s 1,1,2 -N");
+
+  for (int64_t i = 0; i < 10000; ++i) {
+    args.push_back(std::to_string(i % 3000 + 1000));
+  }
+
+  ASSERT_TRUE(parser.Parse(args));
+  ASSERT_EQ(hosts, std::deque<std::string>({"b", "a", "c"}));
+  ASSERT_EQ(parser.GetValues<std::string>("host").size(), 3);
+  ASSERT_EQ(parser.GetStringValue("host", 2), "c");
+  ASSERT_EQ(ports, std::set<int32_t>({8, 16}));
+  ASSERT_EQ(parser.GetValues<int32_t>("port").size(), 2);
+  ASSERT_EQ(parser.GetIntValue("port", 0), 16);
+  ASSERT_EQ(sizes, std::pmr::vector<int64_t>({1, 1, 2}));
+
+  const std::span<const int64_t> numbers = parser.GetValues<int64_t>("number");
+  ASSERT_EQ(numbers.size(), 3000);
+
+  for (int64_t i = 0; i < 3000; ++i) {
+    ASSERT_EQ(numbers[i], i + 1000);
+  }
+
+  ASSERT_FALSE(parser.Parse(SplitString("app -H a a a")));
+  ASSERT_TRUE(parser.Parse(SplitString("app -H a a a a")));
+  ASSERT_EQ(hosts, std::deque<std::string>({"a"}));
+  ASSERT_TRUE(ports.empty());
+}
+
+TEST_F(ArgParserUnitTestSuite, CorpusCaptureTest) {
+  ArgParser parser("My Parser");
+  parser.AddStringArgument('s', "string").Default("");
+  parser.AddFlag('v', "verbose");
+
+  ASSERT_TRUE(parser.StartCorpusCapture(kTemporaryFileName, 2));
+
+  for (size_t i = 0; i < 5; ++i) {
+    static_cast<void>(parser.Parse({"app", "-s", "value " + std::to_string(i), i % 2 == 0 ? "-v" : ""}));
+  }
+
+  parser.StopCorpusCapture();
+  ASSERT_TRUE(parser.StartCorpusCapture(kTemporaryFileName));
+  ASSERT_TRUE(parser.Parse({"app"}));
+  parser.StopCorpusCapture();
+  ASSERT_TRUE(parser.Parse({"app", "-v"}));
+
+  ArgvCorpus corpus;
+  ASSERT_TRUE(corpus.Read(kTemporaryFileName));
+  ASSERT_EQ(corpus.GetSize(), 4);
+  ASSERT_EQ(corpus.GetCommandLine(0).size(), 4);
+  ASSERT_EQ(corpus.GetCommandLine(1)[2], "value 2");
+  ASSERT_EQ(corpus.GetCommandLine(2)[3], "-v");
+  ASSERT_EQ(corpus.GetCommandLine(3).size(), 1);
+  corpus.Clear();
+
+  std::filesystem::resize_file(kTemporaryFileName, std::filesystem::file_size(kTemporaryFileName) - 2);
+  ASSERT_TRUE(corpus.Read(kTemporaryFileName));
+  ASSERT_EQ(corpus.GetSize(), 3);
+  corpus.Clear();
+
+  std::ofstream(kTemporaryFileName) << "not a corpus";
+  ASSERT_FALSE(corpus.Read(kTemporaryFileName));
+  ASSERT_FALSE(parser.StartCorpusCapture(kTemporaryFileName));
+}
+
+TEST_F(ArgParserUnitTestSuite, AllocationTest) {
+  const auto define_schema = [](ArgParser& parser) {
+    parser.AddHelp('h', "help", "Some Description about program");
+    parser.AddFlag('s', "flag1", "Some flag").Default(true);
+    parser.AddFlag('p', "flag2", "Another flag");
+    parser.AddIntArgument("number", "Some Number");
+    parser.AddDoubleArgument('r', "ratio", "Some ratio").Default(0.5);
+    parser.AddStringArgument('n', "name", "Short name").Default("none");
+    parser.AddUnsignedLongLongArgument("N", "Positional numbers").MultiValue(1).Positional();
+  };
+
+  /* Names and descriptions are interned once per process, a parser with the
+   * same schema defined first keeps the interning out of the counts. */
+
+  ArgParser interning_parser("My Parser");
+  define_schema(interning_parser);
+
+  ArgParser parser("My Parser");
+  AllocationCounter schema_counter;
+  define_schema(parser);
+
+  /* Each of the 7 arguments allocates its builder and its node in the map of
+   * its type, each of the 3 flags its node in the map of flag slots, and the
+   * descriptions of help and N do not fit into the small string buffer (19).
+   * The vectors of builders and flag slots grow at most once per argument,
+   * the words of the flags once (15). */
+
+  ASSERT_LE(schema_counter.GetAllocations(), 19 + 15);
+
+  const std::vector<std::string> args = SplitString("app --number 2 -sp -r=1.5 --name short 1 2 3");
+
+  /* The first parse builds an object for each of the 7 arguments, the 3
+   * tables of arguments, the list of positional arguments and the nodes of
+   * the key tree (12); the distance row of the tree grows at most once per
+   * key (7). The tokens and the 3 position buffers are reserved once (4);
+   * the used positions, the environment values, the resolved and the used
+   * arguments are assigned once (4). The values of number, ratio and name
+   * are stored once (3), the vector of N grows at most once per value (3)
+   * and the indices of the bundle "-sp" at most once per key (2). */
+
+  AllocationCounter first_counter;
+  ASSERT_TRUE(parser.Parse(args));
+  ASSERT_LE(first_counter.GetAllocations(), 12 + 7 + 4 + 4 + 3 + 3 + 2);
+
+  AllocationCounter repeated_counter;
+  ASSERT_TRUE(parser.Parse(args));
+  ASSERT_TRUE(parser.Parse(args));
+  ASSERT_EQ(repeated_counter.GetAllocations(), 0);
+
+  AllocationCounter read_counter;
+  ASSERT_TRUE(parser.GetFlag("flag1"));
+  ASSERT_TRUE(parser.GetFlag("flag2"));
+  ASSERT_EQ(parser.GetIntValue("number"), 2);
+  ASSERT_EQ(parser.GetDoubleValue("ratio"), 1.5);
+  ASSERT_EQ(parser.GetStringValue("name"), "short");
+  ASSERT_EQ(parser.GetValueReference<std::string>("name"), "short");
+  ASSERT_EQ(parser.GetUnsignedLongLongValue("N", 2), 3);
+  ASSERT_EQ(parser.GetValues<uint64_t>("N").size(), 3);
+  ASSERT_EQ(read_counter.GetAllocations(), 0);
+
+  AllocationCounter help_counter;
+  const std::string help = parser.HelpDescription();
+
+  /* The help is appended to a single string and all other strings fit into
+   * the small string buffer. The string grows its capacity by at least a half
+   * on every allocation, which bounds their number. */
+
+  size_t help_allocations = 0;
+
+  for (size_t capacity = std::string().capacity(); capacity < help.size(); capacity += capacity / 2) {
+    ++help_allocations;
+  }
+
+  ASSERT_LE(help_counter.GetAllocations(), help_allocations);
+}
+
+TEST_F(ArgParserUnitTestSuite, PathAllocationTest) {
+  ArgParser parser("My Parser");
+  parser.AddHelp('h', "help", "Some Description about program");
+  parser.AddCompositeArgument('i',
+                              "input",
+                              "File path for input file").AddValidate(&IsValidFilename).AddIsGood(&IsRegularFile);
+  parser.AddCompositeArgument('o',
+                              "output",
+                              "File path for output directory").AddValidate(&IsValidFilename).AddIsGood(&IsDirectory);
+  parser.AddFlag('s', "flag1", "Test is a file").Default(true);
+  parser.AddFlag('p', "flag2", "Test is directory");
+  parser.AddIntArgument("number", "Some Number");
+
+  const std::vector<std::string> args = SplitString("app --number 2 -s -i " + kTemporaryFileName + " -o="
+                                                        + kTemporaryDirectoryName);
+
+  AllocationCounter first_counter;
+  ASSERT_TRUE(parser.Parse(args));
+  const size_t first_allocations = first_counter.GetAllocations();
+
+  AllocationCounter query_counter;
+  static_cast<void>(GetPathKind("2"));
+  static_cast<void>(GetPathKind(kTemporaryFileName));
+  static_cast<void>(GetPathKind(kTemporaryDirectoryName));
+  const size_t query_allocations = query_counter.GetAllocations();
+
+  /* On a reused parser only the values that may be paths allocate: the 3
+   * filesystem queries measured above, the 3 nodes of their cache entries,
+   * and for each of the 2 paths longer than the small string buffer its
+   * cache key and the copy passed to the query (4). The composite arguments
+   * copy each path into the value string and into the stored value (4). */
+
+  AllocationCounter repeated_counter;
+  ASSERT_TRUE(parser.Parse(args));
+  ASSERT_LT(repeated_counter.GetAllocations(), first_allocations);
+  ASSERT_LE(repeated_counter.GetAllocations(), query_allocations + 3 + 4 + 4);
+}
+
+TEST_F(ArgParserUnitTestSuite, TokenClassificationTest) {
+  const Token long_key = ClassifyToken("\"--name=a=b\"");
+  ASSERT_EQ(long_key.kind, TokenKind::kLongKey);
+  ASSERT_EQ(long_key.text, "--name=a=b");
+  ASSERT_EQ(long_key.key, "name");
+  ASSERT_TRUE(long_key.has_value);
+  ASSERT_EQ(long_key.value, "a=b");
+
+  const Token bundle = ClassifyToken("-abc");
+  ASSERT_EQ(bundle.kind, TokenKind::kBundle);
+  ASSERT_EQ(bundle.key, "abc");
+  ASSERT_FALSE(bundle.has_value);
+
+  const Token short_key = ClassifyToken("-r=");
+  ASSERT_EQ(short_key.kind, TokenKind::kShortKey);
+  ASSERT_EQ(short_key.key, "r");
+  ASSERT_TRUE(short_key.has_value);
+  ASSERT_TRUE(short_key.value.empty());
+
+  ASSERT_EQ(ClassifyToken("'value'").kind, TokenKind::kValue);
+  ASSERT_EQ(ClassifyToken("'value'").text, "value");
+  ASSERT_EQ(ClassifyToken("").kind, TokenKind::kValue);
+  ASSERT_EQ(ClassifyToken("'--'").kind, TokenKind::kTerminator);
+  ASSERT_EQ(ClassifyToken("-").kind, TokenKind::kShortKey);
+
+  std::vector<Token> tokens;
+  ClassifyTokens(SplitString("app -s 2"), tokens);
+  ASSERT_EQ(tokens.size(), 4);
+  ASSERT_TRUE(tokens.back().IsTerminator());
+
+  ArgParser parser("My Parser");
+  parser.AddFlag('s', "flag", "Some flag");
+  parser.AddStringArgument('n', "name", "Some name");
+  parser.AddIntArgument("N", "Some Number").MultiValue(1).Positional();
+  ASSERT_TRUE(parser.Parse(SplitString("app -s '--name=a=b' 1 \"2\" -- -3")));
+  ASSERT_TRUE(parser.GetFlag("flag"));
+  ASSERT_EQ(parser.GetStringValue("name"), "a=b");
+  ASSERT_EQ(parser.GetValues<int32_t>("N").size(), 2);
+  ASSERT_EQ(parser.GetIntValue("N", 1), 2);
+}
+
+TEST_F(ArgParserUnitTestSuite, SuggestionTest) {
+  ArgParser parser("My Parser");
+  parser.AddCompositeArgument('o', "output", "File path for output");
+  parser.AddIntArgument("threads", "Number of threads").Default(1);
+  parser.AddFlag('v', "verbose", "Verbose output");
+
+  for (size_t i = 0; i < 1500; ++i) {
+    parser.AddIntArgument("option-" + std::to_string(i), "Some number").Default(0);
+  }
+
+  std::ostringstream error_stream;
+  ASSERT_FALSE(parser.Parse(SplitString("app --ouptut=file"), {error_stream, true}));
+  ASSERT_EQ(parser.GetErrors()[0].kind, ParsingErrorKind::kUnknownArgument);
+  ASSERT_EQ(parser.GetErrors()[0].argument, "--ouptut=file");
+  ASSERT_EQ(parser.GetErrors()[0].related, "output");
+  ASSERT_EQ(error_stream.str(), "Used nonexistent argument: --ouptut=file, did you mean --output?\n");
+
+  ASSERT_FALSE(parser.Parse(SplitString("app --thread 4")));
+  ASSERT_EQ(parser.GetErrors()[0].related, "threads");
+
+  ASSERT_FALSE(parser.Parse(SplitString("app --optoin-1024=1")));
+  ASSERT_EQ(parser.GetErrors()[0].related, "option-1024");
+
+  ASSERT_FALSE(parser.Parse(SplitString("app --completely-different")));
+  ASSERT_TRUE(parser.GetErrors()[0].related.empty());
+
+  ASSERT_FALSE(parser.Parse(SplitString("app -x")));
+  ASSERT_TRUE(parser.GetErrors()[0].related.empty());
+
+  /* The tree returns the same distance as a scan of every word. */
+
+  BkTree tree;
+  std::vector<std::string> words;
+  std::vector<size_t> row;
+
+  for (size_t i = 0; i < 300; ++i) {
+    words.push_back(std::to_string(i * 7919 % 1000) + "-key");
+  }
+
+  for (const std::string& word : words) {
+    tree.Insert(word);
+  }
+
+  for (const std::string query : {"12-key", "7-ke", "999-kye", "abc", "100key", "-key"}) {
+    size_t best_distance = 3;
+
+    for (const std::string& word : words) {
+      best_distance = std::min(best_distance, BkTree::GetDistance(query, word, row));
+    }
+
+    const std::string_view closest = tree.FindClosest(query, 2);
+    ASSERT_EQ(closest.empty() ? 3 : BkTree::GetDistance(query, closest, row), best_distance);
+  }
+}
@@ -0,0 +1,146 @@
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include "lib/argparser/ArgParser.hpp"
+
+#if defined _WIN32 || defined _WIN64 || defined __CYGWIN__
+#include <fcntl.h>
+#include <io.h>
+#define ARGPARSER_PIPE(fds) _pipe(fds, 4096, _O_BINARY)
+#define ARGPARSER_READ _read
+#define ARGPARSER_CLOSE _close
+#else
+#include <unistd.h>
+#define ARGPARSER_PIPE(fds) ::pipe(fds)
+#define ARGPARSER_READ ::read
+#define ARGPARSER_CLOSE ::close
+#endif
+
+/* The tests of the build without iostreams. GoogleTest depends on iostreams,
+ * so the checks are plain and the failures are written to stderr. */
+
+using namespace ArgumentParser;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition) \
+  do { \
+    if (!(condition)) { \
+      std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+      ++failures; \
+    } \
+  } while (false)
+
+/* Everything written to the write end of a pipe before it is closed. */
+
+class Pipe {
+ public:
+  Pipe() {
+    if (ARGPARSER_PIPE(descriptors_) != 0) {
+      descriptors_[0] = descriptors_[1] = -1;
+    }
+  }
+
+  ~Pipe() {
+    CloseWriteEnd();
+
+    if (descriptors_[0] >= 0) {
+      ARGPARSER_CLOSE(descriptors_[0]);
+    }
+  }
+
+  [[nodiscard]] bool IsOpen() const {
+    return descriptors_[0] >= 0;
+  }
+
+  [[nodiscard]] int GetWriteEnd() const {
+    return descriptors_[1];
+  }
+
+  std::string ReadAll() {
+    CloseWriteEnd();
+
+    std::string result;
+    char buffer[256];
+
+    for (auto size = ARGPARSER_READ(descriptors_[0], buffer, sizeof(buffer)); size > 0;
+         size = ARGPARSER_READ(descriptors_[0], buffer, sizeof(buffer))) {
+      result.append(buffer, static_cast<size_t>(size));
+    }
+
+    return result;
+  }
+
+ private:
+  void CloseWriteEnd() {
+    if (descriptors_[1] >= 0) {
+      ARGPARSER_CLOSE(descriptors_[1]);
+      descriptors_[1] = -1;
+    }
+  }
+
+  int descriptors_[2] = {-1, -1};
+};
+
+void OutputSinkTest() {
+  Pipe pipe;
+  CHECK(pipe.IsOpen());
+
+  const OutputSink sink(pipe.GetWriteEnd());
+  sink.Write("Some ");
+  sink.Write("Text");
+
+  CHECK(!sink.IsConsole());
+  CHECK(OutputSink(OutputSink::kStandardError).IsConsole());
+  CHECK(pipe.ReadAll() == "Some Text");
+
+  std::string output;
+  const OutputSink callback_sink([&output](std::string_view data) { output += data; });
+  callback_sink.Write("Some Text");
+
+  CHECK(output == "Some Text");
+  CHECK(!callback_sink.IsConsole());
+}
+
+void ErrorOutputTest() {
+  Pipe pipe;
+  ArgParser parser("My Parser");
+  parser.AddIntArgument('n', "number", "Some Number").Default(5);
+
+  CHECK(parser.Parse({"app", "--number=7"}, {OutputSink(pipe.GetWriteEnd()), true}));
+  CHECK(parser.GetIntValue("number") == 7);
+  CHECK(!parser.Parse({"app", "--numbr=7"}, {OutputSink(pipe.GetWriteEnd()), true}));
+  CHECK(pipe.ReadAll().find("numbr") != std::string::npos);
+}
+
+/* The values must be rendered as operator<< renders them with iostreams. */
+
+void FormatValueTest() {
+  CHECK(FormatValue(1.5) == "1.5");
+  CHECK(FormatValue(1.0 / 3) == "0.333333");
+  CHECK(FormatValue(2.0f / 3) == "0.666667");
+  CHECK(FormatValue(1e20) == "1e+20");
+  CHECK(FormatValue(int64_t{-42}) == "-42");
+  CHECK(FormatValue(true) == "1");
+  CHECK(FormatValue('c') == "c");
+  CHECK(FormatValue(std::string("text")) == "text");
+  CHECK(FormatValue(Size{2048}) == "2KiB");
+}
+
+}
+
+int main() {
+  OutputSinkTest();
+  ErrorOutputTest();
+  FormatValueTest();
+
+  if (failures != 0) {
+    std::fprintf(stderr, "%d checks failed\n", failures);
+    return 1;
+  }
+
+  return 0;
+}
@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include <iterator>
 #include <sstream>
 
@@ -9,6 +10,22 @@ std::vector<std::string> SplitString(const std::string& str) {
   return {std::istream_iterator<std::string>(iss), std::istream_iterator<std::string>()};
 }
 
+void SetTestEnvironment(const std::string& name, const std::string& value) {
+#if defined _WIN32 || defined _WIN64 || defined __CYGWIN__
+  _putenv_s(name.c_str(), value.c_str());
+#else
+  setenv(name.c_str(), value.c_str(), 1);
+#endif
+}
+
+void ClearTestEnvironment(const std::string& name) {
+#if defined _WIN32 || defined _WIN64 || defined __CYGWIN__
+  _putenv_s(name.c_str(), "");
+#else
+  unsetenv(name.c_str());
+#endif
+}
+
 std::ostream& operator<<(std::ostream& os, Action action) {
   switch (action) {
     case Action::kSum:
@@ -41,3 +58,70 @@ ArgumentParser::NonMemberParsingResult<Action> ParseAction(const std::string& ac
 }
 
 AddArgumentType(Action, ParseAction)
+
+std::ostream& operator<<(std::ostream& os, const LookupTable& table) {
+  return os << (table.values == nullptr ? 0 : table.values->size());
+}
+
+ArgumentParser::NonMemberParsingResult<LookupTable> ParseLookupTable(std::string_view range) {
+  ArgumentParser::NonMemberParsingResult<LookupTable> result{};
+  const size_t dash_index = range.find('-');
+
+  if (dash_index == std::string_view::npos) {
+    result.success = false;
+    return result;
+  }
+
+  const int first = std::stoi(std::string(range.substr(0, dash_index)));
+  const int last = std::stoi(std::string(range.substr(dash_index + 1)));
+  result.value.values = std::make_unique<std::vector<int>>();
+
+  for (int i = first; i <= last; ++i) {
+    result.value.values->push_back(i);
+  }
+
+  return result;
+}
+
+AddArgumentType(LookupTable, ParseLookupTable)
+
+std::ostream& operator<<(std::ostream& os, const CopyCounter& counter) {
+  return os << counter.text;
+}
+
+bool ParseCopyCounter(std::string_view text, CopyCounter& counter) {
+  counter.text = text;
+  return !text.empty();
+}
+
+AddArgumentType(CopyCounter, ParseCopyCounter)
+
+std::ostream& operator<<(std::ostream& os, const Label& label) {
+  return os << label.text;
+}
+
+bool ParseLabel(std::string_view text, Label& label) {
+  label.text = text;
+  return !text.empty();
+}
+
+AddArgumentType(Label, ParseLabel)
+
+std::ostream& operator<<(std::ostream& os, const Coordinates& coordinates) {
+  return os << coordinates.x << ',' << coordinates.y;
+}
+
+bool ParseCoordinates(std::string_view text, Coordinates& coordinates) {
+  const size_t comma_index = text.find(',');
+
+  if (comma_index == std::string_view::npos) {
+    return false;
+  }
+
+  coordinates.x = std::stoi(std::string(text.substr(0, comma_index)));
+  coordinates.y = std::stoi(std::string(text.substr(comma_index + 1)));
+
+  return true;
+}
+
+AddArgumentType(Coordinates, ParseCoordinates)
@@ -2,8 +2,10 @@
 #define TESTFUNCTIONS_HPP_
 
 #include <iostream>
+#include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "lib/argparser/ConcreteArgument.hpp"
 
@@ -13,10 +15,70 @@ enum class Action {
   kMul = 2,
 };
 
+/* A move-only value: a table of numbers built from a range like "2-5". */
+
+struct LookupTable {
+  std::unique_ptr<std::vector<int>> values;
+};
+
+/* A copyable value that counts how many times values were copied. */
+
+struct CopyCounter {
+  static inline size_t copies = 0;
+
+  std::string text;
+
+  CopyCounter() = default;
+  CopyCounter(const CopyCounter& other) : text(other.text) { ++copies; }
+  CopyCounter(CopyCounter&& other) noexcept = default;
+  CopyCounter& operator=(const CopyCounter& other) {
+    text = other.text;
+    ++copies;
+    return *this;
+  }
+  CopyCounter& operator=(CopyCounter&& other) noexcept = default;
+};
+
+/* A trivially copyable value that points into the parsed text. */
+
+struct Label {
+  std::string_view text;
+};
+
+/* A trivially copyable value without pointers, exported byte by byte. */
+
+struct Coordinates {
+  int x = 0;
+  int y = 0;
+};
+
+template<>
+struct ArgumentParser::RawSerializable<Coordinates> : std::true_type {};
+
 std::vector<std::string> SplitString(const std::string& str);
 
+void SetTestEnvironment(const std::string& name, const std::string& value);
+
+void ClearTestEnvironment(const std::string& name);
+
 std::ostream& operator<<(std::ostream& os, Action action);
 
 ArgumentParser::NonMemberParsingResult<Action> ParseAction(const std::string& action);
 
+std::ostream& operator<<(std::ostream& os, const LookupTable& table);
+
+ArgumentParser::NonMemberParsingResult<LookupTable> ParseLookupTable(std::string_view range);
+
+std::ostream& operator<<(std::ostream& os, const CopyCounter& counter);
+
+bool ParseCopyCounter(std::string_view text, CopyCounter& counter);
+
+std::ostream& operator<<(std::ostream& os, const Label& label);
+
+bool ParseLabel(std::string_view text, Label& label);
+
+std::ostream& operator<<(std::ostream& os, const Coordinates& coordinates);
+
+bool ParseCoordinates(std::string_view text, Coordinates& coordinates);
+
 #endif //TESTFUNCTIONS_HPP_